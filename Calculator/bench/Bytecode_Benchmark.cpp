@@ -0,0 +1,98 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+// Evaluates balanced trees of about ten to about a million nodes over
+// and over, with an Evaluation_Visitor walking the tree and with the
+// bytecode, and reports the time per node of each and the speedup of
+// the bytecode.
+//
+// Usage: Bytecode_Benchmark [nodes per size]
+
+#include "Bytecode.h"
+#include "Evaluation_Visitor.h"
+#include "Expression_Tree.h"
+#include "Interpreter.h"
+#include "Tree_Traversal.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+// Return a balanced expression @a levels levels deep over the
+// variables a and b, which mixes the operators.  b is 1, so nothing
+// divides by zero and no value overflows.
+std::string balanced(int levels)
+{
+    if (levels == 0)
+        return "a";
+    std::string side = balanced(levels - 1);
+    switch (levels % 3) {
+    case 0:
+        return "(" + side + "*b+" + side + ")";
+    case 1:
+        return "(" + side + "-" + side + "/b)";
+    default:
+        return "(" + side + "+" + side + ")";
+    }
+}
+
+// Return the seconds since @a start.
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t work = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000000;
+
+    Interpreter interpreter;
+    Interpreter_Context context;
+    context.set("a", 3);
+    context.set("b", 1);
+
+    std::cout << "    nodes    visitor ns/node  bytecode ns/node  speedup" << std::endl
+              << std::fixed << std::setprecision(2);
+    for (int levels = 2; levels <= 18; levels += 4) {
+        Expression_Tree tree = interpreter.interpret(context, balanced(levels));
+        const std::size_t nodes = tree.get_root()->size();
+        const std::size_t runs = std::max<std::size_t>(1, work / nodes);
+        tree.bytecode();
+
+        std::ostringstream errors;
+        int expected = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t run = 0; run < runs; ++run) {
+            Evaluation_Visitor visitor(errors);
+            Tree_Traversal traversal(tree.get_root(), Tree_Traversal::POST_ORDER);
+            while (const Component_Node* node = traversal.next())
+                node->accept(visitor);
+            expected = visitor.total();
+        }
+        double visited = seconds_since(start);
+
+        int result = 0;
+        start = std::chrono::steady_clock::now();
+        for (std::size_t run = 0; run < runs; ++run)
+            tree.bytecode().evaluate(result);
+        double compiled = seconds_since(start);
+
+        const double total = static_cast<double>(nodes) * runs;
+        std::cout << std::setw(9) << nodes << std::setw(19) << visited * 1e9 / total
+                  << std::setw(18) << compiled * 1e9 / total << std::setw(9)
+                  << visited / compiled << (result == expected ? "" : "  WRONG RESULT")
+                  << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,211 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+// Fills a queue with n items and drains it, over and over, for n from
+// 10 to 10^7, and reports the time per enqueue + dequeue of LQueue,
+// of the LQueue it replaced, which kept one node per item on a static
+// free list, and of std::deque.  Ints and 41-character strings are
+// measured.
+//
+// Usage: LQueue_Benchmark [largest n] [operations per n]
+
+#include "LQueue.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+
+namespace {
+/**
+ * @class Old_LQueue
+ * @brief The enqueue and dequeue of the LQueue before it was rebuilt
+ *        out of chunks: a circular list with one node per item and a
+ *        dummy tail node, whose nodes come from a free list shared by
+ *        every queue of the same type.  Items are copied in and out.
+ */
+template <typename T> class Old_LQueue {
+public:
+    Old_LQueue()
+        : tail(new Node)
+        , count(0)
+    {
+        tail->next = tail;
+    }
+
+    Old_LQueue(const Old_LQueue&) = delete;
+    Old_LQueue& operator=(const Old_LQueue&) = delete;
+
+    ~Old_LQueue()
+    {
+        while (count)
+            dequeue();
+        delete tail;
+    }
+
+    // The dummy node takes the item and points to a new dummy node.
+    void enqueue(const T& item)
+    {
+        Node* dummy = new Node;
+        dummy->next = tail->next;
+        tail->item = item;
+        tail->next = dummy;
+        tail = dummy;
+        ++count;
+    }
+
+    T dequeue()
+    {
+        Node* head = tail->next;
+        T item = head->item;
+        tail->next = head->next;
+        delete head;
+        --count;
+        return item;
+    }
+
+private:
+    /**
+     * @struct Node
+     * @brief An item and the next node, allocated from the free list.
+     */
+    struct Node {
+        T item;
+        Node* next;
+
+        static void* operator new(std::size_t bytes)
+        {
+            if (Node* node = free_list) {
+                free_list = node->next;
+                return node;
+            }
+            return ::operator new(bytes);
+        }
+
+        static void operator delete(void* memory)
+        {
+            if (memory) {
+                Node* node = static_cast<Node*>(memory);
+                node->next = free_list;
+                free_list = node;
+            }
+        }
+
+        static Node* free_list;
+    };
+
+    Node* tail;
+    std::size_t count;
+};
+
+template <typename T> typename Old_LQueue<T>::Node* Old_LQueue<T>::Node::free_list = nullptr;
+
+// Adapters so the same loop runs on every queue.
+template <typename T> void put(LQueue<T>& queue, T item)
+{
+    queue.enqueue(std::move(item));
+}
+
+template <typename T> void put(Old_LQueue<T>& queue, const T& item)
+{
+    queue.enqueue(item);
+}
+
+template <typename T> void put(std::deque<T>& queue, T item)
+{
+    queue.push_back(std::move(item));
+}
+
+template <typename T> T get(LQueue<T>& queue)
+{
+    return queue.dequeue();
+}
+
+template <typename T> T get(Old_LQueue<T>& queue)
+{
+    return queue.dequeue();
+}
+
+template <typename T> T get(std::deque<T>& queue)
+{
+    T item = std::move(queue.front());
+    queue.pop_front();
+    return item;
+}
+
+// What a dequeued item adds to the checksum.
+std::size_t weight(int item)
+{
+    return static_cast<std::size_t>(item);
+}
+
+std::size_t weight(const std::string& item)
+{
+    return item.size() + static_cast<unsigned char>(item.back());
+}
+
+// Fill @a n items into a Queue and drain it, repeated to about @a
+// operations items, and return the nanoseconds per item.  @a make
+// returns the i-th item.  The checksum depends on the order the items
+// come out in, so every queue must give the same one.
+template <typename Queue, typename Make>
+double fill_and_drain(std::size_t n, std::size_t operations, Make make, std::size_t& checksum)
+{
+    const std::size_t rounds = operations / n ? operations / n : 1;
+    Queue queue;
+    checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t round = 0; round < rounds; ++round) {
+        for (std::size_t i = 0; i < n; ++i)
+            put(queue, make(i));
+        for (std::size_t i = 0; i < n; ++i)
+            checksum = checksum * 31 + weight(get(queue));
+    }
+    double seconds
+        = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds * 1e9 / (rounds * n);
+}
+
+// Print the rows of one item type.
+template <typename T, typename Make>
+void measure(const char* name, std::size_t largest, std::size_t operations, Make make)
+{
+    std::cout << name << ", ns per enqueue + dequeue" << std::endl
+              << "         n   LQueue      old    deque" << std::endl;
+    for (std::size_t n = 10; n <= largest; n *= 10) {
+        std::size_t checksums[3];
+        double chunked = fill_and_drain<LQueue<T>>(n, operations, make, checksums[0]);
+        double old = fill_and_drain<Old_LQueue<T>>(n, operations, make, checksums[1]);
+        double deque = fill_and_drain<std::deque<T>>(n, operations, make, checksums[2]);
+        std::cout << std::setw(10) << n << std::setw(9) << chunked << std::setw(9) << old
+                  << std::setw(9) << deque
+                  << (checksums[0] == checksums[1] && checksums[1] == checksums[2]
+                             ? ""
+                             : "  WRONG ORDER")
+                  << std::endl;
+    }
+}
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t largest = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+    const std::size_t operations = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20000000;
+
+    std::cout << std::fixed << std::setprecision(1);
+    measure<int>("ints", largest, operations, [](std::size_t i) { return static_cast<int>(i); });
+
+    // strings too long for the small string buffer, like history lines
+    const std::string line(40, 'x');
+    measure<std::string>("41-character strings", largest / 10, operations / 10,
+        [&](std::size_t i) { return line + static_cast<char>('a' + i % 26); });
+    return 0;
+}
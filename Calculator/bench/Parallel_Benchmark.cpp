@@ -0,0 +1,83 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+// Builds a balanced sum of about 2^levels terms and evaluates it with
+// the bytecode on one thread, then with fork-join on 1 to 64 threads,
+// and reports the time and the speedup over the bytecode of each.
+//
+// Usage: Parallel_Benchmark [levels] [repeats]
+
+#include "Bytecode.h"
+#include "Expression_Tree.h"
+#include "Interpreter.h"
+#include "Parallel_Evaluator.h"
+#include "Thread_Pool.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+// Return the fastest of @a repeats runs of @a body, in seconds.
+template <typename Body> double best_of(int repeats, Body body)
+{
+    double best = 0;
+    for (int i = 0; i < repeats; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        double seconds
+            = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (i == 0 || seconds < best)
+            best = seconds;
+    }
+    return best;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    const int levels = argc > 1 ? std::atoi(argv[1]) : 21;
+    const int repeats = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    // the variable keeps the whole tree from being folded into a leaf
+    std::string expression = "x";
+    for (int level = 0; level < levels; ++level)
+        expression = "(" + expression + "+" + expression + ")";
+
+    Interpreter_Context context;
+    context.set("x", 1);
+    Expression_Tree tree;
+    {
+        Interpreter interpreter;
+        tree = interpreter.interpret(context, expression);
+    }
+    std::string().swap(expression);
+    tree.bytecode();
+
+    int expected = 0;
+    double sequential = best_of(repeats, [&] { tree.bytecode().evaluate(expected); });
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl
+              << tree.get_root()->size() << " nodes, value " << expected << std::endl
+              << std::fixed << std::setprecision(2) << "bytecode, 1 thread: " << sequential * 1e3
+              << " ms" << std::endl
+              << "threads  fork-join ms  speedup" << std::endl;
+
+    for (std::size_t threads = 1; threads <= 64; threads *= 2) {
+        Thread_Pool pool(threads);
+        Parallel_Evaluator evaluator(pool);
+        int result = 0;
+        double seconds = best_of(repeats, [&] { evaluator.evaluate(tree.get_root(), result); });
+        std::cout << std::setw(7) << threads << std::setw(14) << seconds * 1e3 << std::setw(9)
+                  << sequential / seconds << (result == expected ? "" : "  WRONG RESULT")
+                  << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+// Parses expressions of 10^3 to 10^7 tokens that mix precedences,
+// parentheses, unary minus and variables, and reports the time per
+// token of each, which stays flat if parsing is linear.
+//
+// Usage: Parser_Benchmark [largest] [repeats]
+
+#include "Expression_Tree.h"
+#include "Interpreter.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+// Each unit is 13 tokens: ( a + 1 ) * - 2 - b / 3 ^
+const char UNIT[] = "(a+1)*-2-b/3^";
+const std::size_t UNIT_TOKENS = 13;
+
+// Return an expression of about @a tokens tokens.
+std::string make_expression(std::size_t tokens)
+{
+    std::string expression;
+    expression.reserve(tokens / UNIT_TOKENS * (sizeof(UNIT) - 1) + 1);
+    for (std::size_t i = 0; i + UNIT_TOKENS < tokens; i += UNIT_TOKENS)
+        expression += UNIT;
+    expression += "2";
+    return expression;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t largest = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+    const int repeats = argc > 2 ? std::atoi(argv[2]) : 3;
+
+    Interpreter_Context context;
+    Interpreter interpreter;
+    std::cout << "    tokens       nodes    best ms  ns/token" << std::endl
+              << std::fixed;
+    for (std::size_t tokens = 1000; tokens <= largest; tokens *= 10) {
+        std::string expression = make_expression(tokens);
+        double best = 0;
+        std::size_t nodes = 0;
+        for (int i = 0; i < repeats; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            Expression_Tree tree = interpreter.interpret(context, expression);
+            double seconds
+                = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (i == 0 || seconds < best)
+                best = seconds;
+            nodes = tree.get_root()->size();
+        }
+        std::cout << std::setw(10) << tokens << std::setw(12) << nodes << std::setw(11)
+                  << std::setprecision(2) << best * 1e3 << std::setw(10) << std::setprecision(1)
+                  << best * 1e9 / tokens << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,172 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+// Measures BQueue against an LQueue guarded by a mutex with 1 to 64
+// threads that each enqueue an item and dequeue one, over and over, and
+// one producer streaming items to one consumer through each queue.
+//
+// Usage: Queue_Benchmark [operations]
+
+#include "BQueue.h"
+#include "LQueue.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+// Room in the bounded queues, more than the most threads.
+const std::size_t CAPACITY = 1024;
+
+// Items moved at once by the batch methods.
+const std::size_t BATCH = 16;
+
+/**
+ * @class Locked_Queue
+ * @brief An LQueue behind a mutex, with the try_ methods of BQueue.
+ */
+class Locked_Queue {
+public:
+    explicit Locked_Queue(std::size_t size)
+        : queue(size)
+    {
+    }
+
+    bool try_enqueue(int item)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        queue.enqueue(item);
+        return true;
+    }
+
+    bool try_dequeue(int& item)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (queue.is_empty())
+            return false;
+        item = queue.dequeue();
+        return true;
+    }
+
+private:
+    std::mutex lock;
+    LQueue<int> queue;
+};
+
+// Enqueue @a item, yielding while the queue is full.
+template <typename Queue> void put(Queue& queue, int item)
+{
+    while (!queue.try_enqueue(item))
+        std::this_thread::yield();
+}
+
+// Dequeue an item, yielding while there is none.
+template <typename Queue> int get(Queue& queue)
+{
+    int item;
+    while (!queue.try_dequeue(item))
+        std::this_thread::yield();
+    return item;
+}
+
+// Run @a body on @a threads threads at once and return the seconds
+// they took.
+template <typename Body> double run(std::size_t threads, Body body)
+{
+    std::vector<std::thread> running;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < threads; ++i)
+        running.emplace_back(body);
+    for (std::thread& thread : running)
+        thread.join();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Return millions of operations per second.
+double rate(std::size_t operations, double seconds)
+{
+    return seconds > 0 ? operations / seconds / 1e6 : 0.0;
+}
+
+// Each of @a threads threads enqueues and dequeues @a count / @a threads
+// items.  Returns millions of operations per second.
+template <typename Queue> double pairs(std::size_t threads, std::size_t count)
+{
+    Queue queue(CAPACITY);
+    const std::size_t each = count / threads;
+    double seconds = run(threads, [&] {
+        for (std::size_t i = 0; i < each; ++i) {
+            put(queue, static_cast<int>(i));
+            get(queue);
+        }
+    });
+    return rate(2 * each * threads, seconds);
+}
+
+// Same with batches of BATCH items.
+double batch_pairs(std::size_t threads, std::size_t count)
+{
+    BQueue<int> queue(CAPACITY * BATCH);
+    const std::size_t each = count / threads / BATCH;
+    double seconds = run(threads, [&] {
+        int items[BATCH] = {};
+        for (std::size_t i = 0; i < each; ++i) {
+            for (std::size_t done = 0; done < BATCH;)
+                done += queue.try_enqueue(items + done, BATCH - done);
+            for (std::size_t done = 0; done < BATCH;)
+                done += queue.try_dequeue(items + done, BATCH - done);
+        }
+    });
+    return rate(2 * each * BATCH * threads, seconds);
+}
+
+// One thread sends @a items items to another.
+template <typename Queue> double stream(std::size_t items)
+{
+    Queue queue(CAPACITY);
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer([&] {
+        for (std::size_t i = 0; i < items; ++i)
+            put(queue, static_cast<int>(i));
+    });
+    std::thread consumer([&] {
+        for (std::size_t i = 0; i < items; ++i)
+            get(queue);
+    });
+    producer.join();
+    consumer.join();
+    return rate(
+        2 * items, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+}
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t operations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4000000;
+
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl
+              << "million operations per second, each thread enqueues then dequeues"
+              << std::endl
+              << "threads  mutex+LQueue  BQueue  BQueue batch" << std::endl
+              << std::fixed << std::setprecision(1);
+    for (std::size_t threads = 1; threads <= 64; threads *= 2)
+        std::cout << std::setw(7) << threads << std::setw(14)
+                  << pairs<Locked_Queue>(threads, operations / 2) << std::setw(8)
+                  << pairs<BQueue<int>>(threads, operations / 2) << std::setw(14)
+                  << batch_pairs(threads, operations / 2) << std::endl;
+
+    std::cout << "one producer, one consumer" << std::endl
+              << "  mutex+LQueue " << stream<Locked_Queue>(operations / 2) << std::endl
+              << "  BQueue       " << stream<BQueue<int>>(operations / 2) << std::endl
+              << "  BQueue SPSC  " << stream<BQueue<int, true>>(operations / 2) << std::endl;
+    return 0;
+}
@@ -0,0 +1,206 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+// Serves a loopback TCP port with 1 to 8 event loops, one per core,
+// each with a server of its own on the port through SO_REUSEPORT, as
+// "ExpressionTree -S port -r N" does.  Client threads open sessions
+// that each send a number of expressions, and the benchmark reports
+// the sessions and expressions served per second and the speedup over
+// one event loop.  The clients run on the same cores as the servers.
+//
+// Usage: Server_Benchmark [clients] [sessions per client] [expressions per session]
+
+#include "Event_Handler.h"
+#include "Expression_Tree_Server.h"
+#include "Reactor.h"
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+/**
+ * @class Stopper
+ * @brief Ends the event loop of its thread once it is told to, since
+ *        another thread can't end it.
+ */
+class Stopper : public Event_Handler {
+public:
+    explicit Stopper(const std::atomic<bool>& stop)
+        : stop(stop)
+    {
+    }
+
+    // It only has a timer.
+    virtual int get_handle() const
+    {
+        return -1;
+    }
+
+    virtual void handle_open()
+    {
+        Reactor::instance()->schedule_timer(
+            this, std::chrono::milliseconds(10), std::chrono::milliseconds(10));
+    }
+
+    virtual void handle_input() {}
+
+    virtual void handle_timeout(long)
+    {
+        if (stop)
+            Reactor::instance()->end_event_loop();
+    }
+
+private:
+    const std::atomic<bool>& stop;
+};
+
+// Return the port the server listens on.
+int port_of(const Expression_Tree_Server& server)
+{
+    sockaddr_in address {};
+    socklen_t length = sizeof(address);
+    if (getsockname(server.get_handle(), reinterpret_cast<sockaddr*>(&address), &length) < 0)
+        throw std::domain_error("Can't get the port of the server");
+    return ntohs(address.sin_port);
+}
+
+// Open a session on @a port, send it @a request and return what it
+// answers once it has closed the connection.
+std::string session(int port, const std::string& request)
+{
+    int handle = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    std::string reply;
+    if (handle >= 0 && connect(handle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0
+        && send(handle, request.data(), request.size(), MSG_NOSIGNAL)
+            == static_cast<ssize_t>(request.size())) {
+        shutdown(handle, SHUT_WR);
+        char buffer[4096];
+        ssize_t count;
+        while ((count = recv(handle, buffer, sizeof(buffer), 0)) > 0)
+            reply.append(buffer, count);
+    }
+    if (handle >= 0)
+        close(handle);
+    return reply;
+}
+
+// Return the cores this process may run on.
+std::vector<int> allowed_cores()
+{
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    sched_getaffinity(0, sizeof(allowed), &allowed);
+    std::vector<int> cores;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        if (CPU_ISSET(cpu, &allowed))
+            cores.push_back(cpu);
+    return cores;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    const int clients = argc > 1 ? std::atoi(argv[1]) : 16;
+    const int sessions = argc > 2 ? std::atoi(argv[2]) : 200;
+    const int expressions = argc > 3 ? std::atoi(argv[3]) : 20;
+
+    // every session sends the same expressions and must get the same
+    // values back, before the reply to the end of its input
+    std::string request;
+    std::string expected;
+    for (int i = 0; i < expressions; ++i) {
+        request += "(" + std::to_string(i) + " + 3) * 7 - " + std::to_string(i) + " / 2\n";
+        expected += "> " + std::to_string((i + 3) * 7 - i / 2) + "\n";
+    }
+
+    const std::vector<int> cores = allowed_cores();
+    std::cout << "cores: " << cores.size() << ", " << clients << " clients, " << sessions
+              << " sessions each, " << expressions << " expressions per session" << std::endl
+              << "reactors  sessions/s  expressions/s  speedup" << std::endl
+              << std::fixed << std::setprecision(0);
+
+    double single = 0;
+    for (std::size_t reactors = 1; reactors <= 8; reactors *= 2) {
+        std::vector<std::unique_ptr<Expression_Tree_Server>> servers;
+        int port;
+        try {
+            servers.emplace_back(new Expression_Tree_Server("127.0.0.1:0"));
+            port = port_of(*servers.front());
+            while (servers.size() < reactors)
+                servers.emplace_back(servers.front()->clone());
+        } catch (std::domain_error& e) {
+            std::cerr << "ERROR: " << e.what() << std::endl;
+            return 1;
+        }
+
+        std::atomic<bool> stop(false);
+        std::vector<std::thread> loops;
+        for (std::size_t index = 0; index < reactors; ++index) {
+            loops.emplace_back([&, index](Expression_Tree_Server* server) {
+                cpu_set_t core;
+                CPU_ZERO(&core);
+                CPU_SET(cores[index % cores.size()], &core);
+                pthread_setaffinity_np(pthread_self(), sizeof(core), &core);
+
+                std::unique_ptr<Reactor> reactor(Reactor::instance());
+                reactor->register_input_handler(server);
+                reactor->register_input_handler(new Stopper(stop));
+                reactor->run_event_loop();
+            },
+                servers[index].release());
+        }
+
+        std::atomic<int> wrong(0);
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> users;
+        for (int client = 0; client < clients; ++client) {
+            users.emplace_back([&] {
+                for (int i = 0; i < sessions; ++i)
+                    if (session(port, request).compare(0, expected.size(), expected) != 0)
+                        ++wrong;
+            });
+        }
+        for (std::thread& user : users)
+            user.join();
+        double seconds
+            = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        stop = true;
+        for (std::thread& loop : loops)
+            loop.join();
+
+        const double served = static_cast<double>(clients) * sessions / seconds;
+        if (reactors == 1)
+            single = served;
+        std::cout << std::setw(8) << reactors << std::setw(12) << served << std::setw(15)
+                  << served * expressions << std::setw(9) << std::setprecision(2)
+                  << served / single << std::setprecision(0);
+        if (wrong)
+            std::cout << "  " << wrong << " WRONG REPLIES";
+        std::cout << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,91 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+// Evaluates succinct-mode input lines with the fused path of
+// Expression_Tree_Context::evaluate_expression() and with the macro
+// command they used to make, and reports the time per line of each, the
+// speedup, and whether both printed the same.  Lines are the same
+// constant, the same cached expression, or all different expressions.
+//
+// Usage: Succinct_Benchmark [lines] [repeats]
+
+#include "Expression_Tree_Command.h"
+#include "Expression_Tree_Command_Factory.h"
+#include "Expression_Tree_Context.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+// Return the fastest of @a repeats runs of @a body, in seconds.  Each
+// run gets a fresh context, so the cache starts out empty.
+template <typename Body> double best_of(int repeats, std::string& output, Body body)
+{
+    double best = 0;
+    for (int i = 0; i < repeats; ++i) {
+        std::ostringstream stream;
+        Expression_Tree_Context context(stream);
+        auto start = std::chrono::steady_clock::now();
+        body(context);
+        double seconds
+            = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (i == 0 || seconds < best)
+            best = seconds;
+        output = stream.str();
+    }
+    return best;
+}
+
+// Print the times of both paths over @a lines.
+void measure(const char* name, const std::vector<std::string>& lines, int repeats)
+{
+    std::string fused_output;
+    double fused = best_of(repeats, fused_output, [&](Expression_Tree_Context& context) {
+        for (const std::string& line : lines)
+            context.evaluate_expression(line);
+    });
+
+    std::string command_output;
+    double commands = best_of(repeats, command_output, [&](Expression_Tree_Context& context) {
+        Expression_Tree_Command_Factory factory(context);
+        for (const std::string& line : lines)
+            factory.make_macro_command(line).execute();
+    });
+
+    std::cout << std::left << std::setw(22) << name << std::right << std::setw(12)
+              << commands * 1e9 / lines.size() << std::setw(10) << fused * 1e9 / lines.size()
+              << std::setw(9) << commands / fused
+              << (fused_output == command_output ? "" : "  DIFFERENT OUTPUT") << std::endl;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    const int repeats = argc > 2 ? std::atoi(argv[2]) : 3;
+
+    std::vector<std::string> constant(count, "1");
+    std::vector<std::string> cached(count, "1+2*3");
+    std::vector<std::string> distinct;
+    distinct.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+        distinct.push_back(std::to_string(i) + "+2*3");
+
+    std::cout << count << " lines, ns per line" << std::endl
+              << "                          commands     fused  speedup" << std::endl
+              << std::fixed << std::setprecision(1);
+    measure("\"1\" on every line", constant, repeats);
+    measure("\"1+2*3\", cached", cached, repeats);
+    measure("distinct expressions", distinct, repeats);
+    return 0;
+}
@@ -0,0 +1,109 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+// Builds a left-deep tree of about 10M nodes from 1+1+...+1, walks it
+// in each order with the stack and through parent links (-t), and
+// reports the time and the extra heap each walk needs, then the time it
+// takes to free the tree.
+//
+// Usage: Traversal_Benchmark [terms]
+
+#include "Expression_Tree.h"
+#include "Interpreter.h"
+#include "Tree_Traversal.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+
+namespace {
+// Bytes currently allocated, and the most allocated since the last
+// reset.
+std::size_t allocated = 0;
+std::size_t peak = 0;
+
+// Room in front of each allocation for its size.
+const std::size_t HEADER = alignof(std::max_align_t);
+
+// Return the seconds since @a start.
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+void* operator new(std::size_t size)
+{
+    char* memory = static_cast<char*>(std::malloc(size + HEADER));
+    if (!memory)
+        throw std::bad_alloc();
+    *reinterpret_cast<std::size_t*>(memory) = size;
+    allocated += size;
+    if (allocated > peak)
+        peak = allocated;
+    return memory + HEADER;
+}
+
+void operator delete(void* memory) noexcept
+{
+    if (memory) {
+        char* block = static_cast<char*>(memory) - HEADER;
+        allocated -= *reinterpret_cast<std::size_t*>(block);
+        std::free(block);
+    }
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    operator delete(memory);
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t terms = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5000000;
+
+    std::string expression = "1";
+    expression.reserve(2 * terms);
+    for (std::size_t i = 1; i < terms; ++i)
+        expression += "+1";
+
+    auto start = std::chrono::steady_clock::now();
+    Interpreter_Context context;
+    Expression_Tree tree;
+    {
+        Interpreter interpreter;
+        tree = interpreter.interpret(context, expression);
+    }
+    std::string().swap(expression);
+    std::cout << std::fixed << std::setprecision(2) << "built " << tree.get_root()->size()
+              << " nodes in " << seconds_since(start) << " s" << std::endl;
+
+    const char* names[] = { "in-order", "pre-order", "post-order", "level-order" };
+    for (const char* name : names) {
+        for (bool threaded : { false, true }) {
+            peak = allocated;
+            const std::size_t before = allocated;
+            start = std::chrono::steady_clock::now();
+            std::size_t visited = 0;
+            Tree_Traversal traversal(tree.get_root(), Tree_Traversal::order(name), threaded);
+            while (traversal.next())
+                ++visited;
+            std::cout << std::setw(12) << name << (threaded ? " threaded" : "    stack") << ": "
+                      << visited << " nodes in " << seconds_since(start) << " s, "
+                      << (peak - before) / 1e6 << " MB extra" << std::endl;
+        }
+    }
+
+    start = std::chrono::steady_clock::now();
+    tree = Expression_Tree();
+    std::cout << "freed in " << seconds_since(start) << " s" << std::endl;
+    return 0;
+}
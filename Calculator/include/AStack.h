@@ -0,0 +1,151 @@
+/* -*- C++ -*- */
+#ifndef ASTACK_H
+#define ASTACK_H
+
+// This header defines "size_t"
+#include <cstdlib>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @class AStack
+ * @brief Defines a generic "last-in/first-out" (LIFO) Abstract Data
+ *        Type (ADT) using a stack that's implemented as an array.
+ *
+ *        The first @a N items are stored inside the stack itself, so a
+ *        stack that stays that small never allocates.  Past that the
+ *        items move to the heap, whose capacity doubles each time it
+ *        fills up.  Otherwise this behaves like @a LStack.
+ */
+template <typename T, size_t N = 32> class AStack {
+public:
+    // Define a "trait"
+    typedef T value_type;
+
+    /**
+     * @class Underflow
+     * @brief Exception thrown by methods in this class when an
+     *        underflow condition occurs.
+     */
+    class Underflow {
+    };
+
+    /**
+     * @class Overflow.
+     * @brief Exception thrown by methods in this class when an overflow
+     *        condition occurs.
+     */
+    class Overflow {
+    };
+
+    /// Constructor.  Room for @a size_hint items is reserved up front.
+    AStack(size_t size_hint = 0);
+
+    /// Copy constructor.
+    AStack(const AStack<T, N>& rhs);
+
+    /// Move constructor, which leaves @a rhs empty.
+    AStack(AStack<T, N>&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+    /// Assignment operator.
+    AStack<T, N>& operator=(const AStack<T, N>& rhs);
+
+    /// Move assignment operator.
+    AStack<T, N>& operator=(AStack<T, N>&& rhs) noexcept(
+        std::is_nothrow_move_constructible<T>::value);
+
+    /// Perform actions needed when stack goes out of scope.
+    ~AStack();
+
+    /// Place a @a new_item on top of the stack.  Throws the @a
+    /// Overflow exception if memory is exhausted.
+    void push(const T& new_item);
+
+    /// Move a @a new_item on top of the stack.
+    void push(T&& new_item);
+
+    /// Construct an item from @a args on top of the stack.
+    template <typename... Args> void emplace(Args&&... args);
+
+    /// Remove and return the top item on the stack.  Throws the @a
+    /// Underflow exception if the stack is empty.
+    T pop();
+
+    /// Returns the top item without removing it.  Throws the @a
+    /// Underflow exception if the stack is empty.
+    T& top();
+
+    /// Returns the top item without removing it.  Throws the @a
+    /// Underflow exception if the stack is empty.
+    const T& top() const;
+
+    /// Returns 1 if the stack is empty, otherwise returns 0.
+    bool is_empty() const;
+
+    /// Returns 1 if the stack is full, otherwise returns 0.
+    bool is_full() const;
+
+    /// Returns the current number of elements in the stack.
+    size_t size() const;
+
+    /// Compare this stack with @a rhs for equality.  Returns true if
+    /// the size's of the two stacks are equal and all the elements from
+    /// 0 .. size() are equal, else false.
+    bool operator==(const AStack<T, N>& rhs) const;
+
+    // Compare this stack with @a rhs for inequality such that @a
+    // *this!=s is always the complement of the boolean return value of
+    // @a *this==s.
+    bool operator!=(const AStack<T, N>& s) const;
+
+    /// Remove all the items, keeping the storage.
+    void erase();
+
+    // Iterators go from the top of the stack down, like @a LStack's.
+    typedef std::reverse_iterator<T*> iterator;
+    typedef std::reverse_iterator<const T*> const_iterator;
+
+    /// Get an iterator that points to the top of the stack.
+    iterator begin();
+
+    /// Get a const iterator that points to the top of the stack.
+    const_iterator begin() const;
+
+    /// Get an iterator that points past the bottom of the stack.
+    iterator end();
+
+    /// Get a const iterator that points past the bottom of the stack.
+    const_iterator end() const;
+
+protected:
+    /// Remove the top item on the stack.  Does not throw exceptions.
+    void pop_i();
+
+    /// Move the items to a heap array of @a larger items, in which @a
+    /// make has already constructed the item at size().
+    template <typename MAKE> void grow(size_t larger, MAKE make);
+
+    /// Move all the items of @a rhs to this empty stack.
+    void take(AStack<T, N>& rhs);
+
+    /// Return true if the items are in the inline buffer.
+    bool is_inline() const;
+
+private:
+    /// The items, either @a buffer or a heap array.
+    T* items;
+
+    /// Number of items that are currently in the stack.
+    size_t count;
+
+    /// Number of items that fit in @a items.
+    size_t capacity;
+
+    /// Storage for the first N items.
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type buffer[N];
+};
+
+#include "../src/AStack.cpp"
+
+#endif // ASTACK_H
@@ -0,0 +1,70 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+
+/**
+ * @class Arena
+ * @brief A bump allocator that carves objects out of large blocks and
+ *        gives all of them back at once.
+ *
+ *        Objects placed in an Arena are never destroyed one by one, so
+ *        they must not own any resources of their own.  The first
+ *        block is kept across reset() calls so an Arena that is reused
+ *        for similar sized work stops calling malloc altogether.
+ */
+class Arena {
+public:
+    // Constructor.
+    explicit Arena(std::size_t block_size = 64 * 1024);
+
+    // Destructor frees every block.
+    ~Arena();
+
+    // Arenas own raw memory, so they are not copyable.
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Return @a bytes of memory aligned to @a alignment.
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+
+    // Release everything allocated so far.
+    void reset();
+
+private:
+    // Header of a block of memory, the usable memory follows it.
+    struct Block {
+        // Next (older) block.
+        Block* next;
+        // Number of usable bytes in the block.
+        std::size_t size;
+    };
+
+    // Start a new block big enough for @a bytes.
+    void grow(std::size_t bytes);
+
+    // Return the first usable byte of @a block.
+    static char* begin(Block* block);
+
+    // Most recently allocated block.
+    Block* head;
+
+    // Next free byte in the head block.
+    char* cursor;
+
+    // One past the last usable byte in the head block.
+    char* limit;
+
+    // Default size of a block.
+    std::size_t block_size;
+};
+
+#endif // ARENA_H
@@ -0,0 +1,205 @@
+/* -*- C++ -*- */
+#ifndef BQUEUE_H
+#define BQUEUE_H
+
+// This header defines "size_t"
+#include <atomic>
+#include <cstdlib>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @class BQueue
+ * @brief Defines a bounded "first-in/first-out" (FIFO) queue that any
+ *        number of threads can use at once without locks.
+ *
+ *        The items live in a ring of cells whose size is a power of
+ *        two.  Each cell has a sequence number that says whether it is
+ *        ready to be written or read on the current lap of the ring,
+ *        so producers and consumers only contend on one counter each
+ *        and never wait for each other.  The try_ methods fail instead
+ *        of blocking when the queue is full or empty.  enqueue() and
+ *        dequeue() throw @a Overflow and @a Underflow instead, like
+ *        the other queues.
+ *
+ *        Copying or moving an item into its cell happens after the cell
+ *        is claimed, so a T whose copy constructor throws terminates.
+ *
+ *        BQueue<T, true> is a cheaper version for exactly one producer
+ *        thread and one consumer thread.
+ */
+template <typename T, bool SPSC = false> class BQueue {
+public:
+    // Define a "trait"
+    typedef T value_type;
+
+    /**
+     * @class Underflow
+     * @brief Exception thrown by methods in this class when an
+     *        underflow condition occurs.
+     */
+    class Underflow {
+    };
+
+    /**
+     * @class Overflow
+     * @brief Exception thrown by methods in this class when an overflow
+     *        condition occurs.
+     */
+    class Overflow {
+    };
+
+    /// Constructor.  Room for at least @a size items.
+    explicit BQueue(size_t size);
+
+    BQueue(const BQueue<T, SPSC>&) = delete;
+    BQueue<T, SPSC>& operator=(const BQueue<T, SPSC>&) = delete;
+
+    /// Destroy the items that are left.  No other thread may be using
+    /// the queue.
+    ~BQueue();
+
+    /// Place a copy of @a new_item at the tail of the queue.  Returns
+    /// false if the queue is full.
+    bool try_enqueue(const T& new_item);
+
+    /// Move @a new_item to the tail of the queue.  Returns false, and
+    /// leaves @a new_item alone, if the queue is full.
+    bool try_enqueue(T&& new_item);
+
+    /// Move up to @a n items starting at @a items to the tail of the
+    /// queue, all in one step.  Returns how many were enqueued.
+    size_t try_enqueue(T* items, size_t n);
+
+    /// Move the front item into @a item.  Returns false if the queue is
+    /// empty.
+    bool try_dequeue(T& item);
+
+    /// Move up to @a n items from the front of the queue to @a items,
+    /// all in one step.  Returns how many were dequeued.
+    size_t try_dequeue(T* items, size_t n);
+
+    /// Place a @a new_item at the tail of the queue.  Throws the @a
+    /// Overflow exception if the queue is full.
+    void enqueue(const T& new_item);
+
+    /// Remove and return the front item on the queue.  Throws the @a
+    /// Underflow exception if the queue is empty.
+    T dequeue();
+
+    /// Returns 1 if the queue is empty, otherwise returns 0.  Only a
+    /// hint while other threads are using the queue.
+    bool is_empty() const;
+
+    /// Returns 1 if the queue is full, otherwise returns 0.  Only a
+    /// hint while other threads are using the queue.
+    bool is_full() const;
+
+    /// Returns the current number of elements in the queue.  Only a
+    /// hint while other threads are using the queue.
+    size_t size() const;
+
+    /// Returns the most items the queue holds.
+    size_t capacity() const;
+
+private:
+    /**
+     * @struct Cell
+     * @brief An item and the lap of the ring it belongs to.
+     */
+    struct Cell {
+        std::atomic<size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+        T* item();
+    };
+
+    /// Claim up to @a n cells at the tail, returning the first position
+    /// and the number claimed in @a n.
+    size_t claim_tail(size_t& n);
+
+    /// Claim up to @a n cells at the head, the same way.
+    size_t claim_head(size_t& n);
+
+    /// Construct the item at the claimed @a position and publish it.
+    template <typename... Args> void put(size_t position, Args&&... args) noexcept;
+
+    /// Move out the item at the claimed @a position and free its cell.
+    T take(size_t position) noexcept;
+
+    /// Move the item at the claimed @a position into @a item and free
+    /// its cell.
+    void take(size_t position, T& item) noexcept;
+
+    Cell* cells;
+    size_t mask;
+    // Each counter on its own cache line, so producers and consumers
+    // don't slow each other down.
+    alignas(64) std::atomic<size_t> tail;
+    alignas(64) std::atomic<size_t> head;
+};
+
+/**
+ * @class BQueue<T, true>
+ * @brief The single-producer, single-consumer version of @a BQueue.
+ *
+ *        Each side owns one counter and only reads the other's, which
+ *        it caches until the queue looks full or empty.  Only one
+ *        thread may enqueue and only one may dequeue.
+ */
+template <typename T> class BQueue<T, true> {
+public:
+    typedef T value_type;
+
+    class Underflow {
+    };
+
+    class Overflow {
+    };
+
+    explicit BQueue(size_t size);
+
+    BQueue(const BQueue<T, true>&) = delete;
+    BQueue<T, true>& operator=(const BQueue<T, true>&) = delete;
+
+    ~BQueue();
+
+    bool try_enqueue(const T& new_item);
+    bool try_enqueue(T&& new_item);
+    size_t try_enqueue(T* items, size_t n);
+    bool try_dequeue(T& item);
+    size_t try_dequeue(T* items, size_t n);
+    void enqueue(const T& new_item);
+    T dequeue();
+    bool is_empty() const;
+    bool is_full() const;
+    size_t size() const;
+    size_t capacity() const;
+
+private:
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+
+    /// Return the item at @a position.
+    T* item(size_t position);
+
+    /// Return how many of @a n items fit, refreshing the cached head
+    /// only if needed.
+    size_t room(size_t n);
+
+    /// Return how many of @a n items are ready, refreshing the cached
+    /// tail only if needed.
+    size_t ready(size_t n);
+
+    Slot* slots;
+    size_t mask;
+    // Written by the producer.
+    alignas(64) std::atomic<size_t> tail;
+    size_t cached_head;
+    // Written by the consumer.
+    alignas(64) std::atomic<size_t> head;
+    size_t cached_tail;
+};
+
+#include "../src/BQueue.cpp"
+
+#endif // BQUEUE_H
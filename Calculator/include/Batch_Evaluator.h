@@ -0,0 +1,54 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#ifndef BATCH_EVALUATOR_H
+#define BATCH_EVALUATOR_H
+
+#include <cstddef>
+#include <vector>
+
+// Forward declarations.
+class Bytecode;
+
+/**
+ * @class Batch_Evaluator
+ * @brief Evaluates one compiled expression over many rows of variable
+ *        values at once.
+ *
+ *        The values of each variable are a column, and the Bytecode
+ *        program is run one instruction at a time over a block of rows:
+ *        every instruction is a kernel that loops over whole columns,
+ *        so the dispatch is paid once per block instead of once per
+ *        row.  The kernels use AVX2 when the processor has it and plain
+ *        loops otherwise.
+ */
+class Batch_Evaluator {
+public:
+    // Number of rows that go through the program together.
+    static constexpr std::size_t block_size = 1024;
+
+    // Evaluate with @a bytecode, which must outlive the evaluator.
+    explicit Batch_Evaluator(const Bytecode& bytecode);
+
+    // Evaluate @a rows rows into @a results.  @a columns is indexed by
+    // variable slot and points at @a rows values for that variable; a
+    // missing or null column uses the value in the context instead.
+    // Rows that divide or take a modulus by zero get a result of 0, and
+    // the opcode that failed first (Bytecode::DIVIDE or
+    // Bytecode::MODULUS) in @a errors.  Returns the number of those rows.
+    std::size_t evaluate(const std::vector<const int*>& columns, std::size_t rows, int* results,
+        char* errors) const;
+
+    // Return whether the AVX2 kernels are used.
+    static bool vectorized();
+
+private:
+    const Bytecode& bytecode;
+};
+
+#endif // BATCH_EVALUATOR_H
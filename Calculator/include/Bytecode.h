@@ -0,0 +1,99 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Forward declarations.
+class Component_Node;
+class Interpreter_Context;
+
+/**
+ * @class Bytecode
+ * @brief An expression tree compiled into a flat postfix program, and
+ *        the stack machine that runs it.
+ *
+ *        Each node becomes one instruction in post-order, so running
+ *        the program is a loop over a contiguous array instead of an
+ *        iterator plus two virtual calls per node.  Nodes that are
+ *        shared by several parents are computed once and kept in a
+ *        temporary.  The value stack is sized from the deepest point of
+ *        the program when it is compiled.
+ */
+class Bytecode {
+public:
+    // The instructions of the stack machine.
+    enum Opcode : std::uint8_t {
+        NUMBER, // push the operand
+        VARIABLE, // push the value of variable slot operand
+        LOAD, // push temporary operand
+        STORE, // copy the top of the stack into temporary operand
+        NEGATE,
+        FACTORIAL,
+        ADD,
+        SUBTRACT,
+        MULTIPLY,
+        DIVIDE,
+        MODULUS,
+        POWER,
+        RETURN // stop, the result is on top of the stack
+    };
+
+    /**
+     * @struct Instruction
+     * @brief An opcode and its operand, if it has one.
+     */
+    struct Instruction {
+        Opcode op;
+        int operand;
+    };
+
+    // Compile the tree rooted at @a root, which must not be null.
+    explicit Bytecode(const Component_Node* root);
+
+    // Run the program and store its value in @a result.  Returns false
+    // without a result on division or modulus by zero, so the caller
+    // can report the error the way Evaluation_Visitor does.
+    bool evaluate(int& result) const;
+
+    // Run the program with the variables read from @a variables, which
+    // is indexed by slot, instead of the context.  The program is only
+    // read, so several threads can run it at once with their own
+    // variables.  On division or modulus by zero the instruction that
+    // failed (DIVIDE or MODULUS) is stored in @a failed, if given.
+    bool evaluate(const int* variables, int& result, Opcode* failed = nullptr) const;
+
+    // Return the instructions.
+    const std::vector<Instruction>& program() const;
+
+    // Return the most values the program ever has on its stack.
+    std::size_t depth() const;
+
+    // Return the number of temporaries the program uses.
+    std::size_t temporaries() const;
+
+    // Return the context the variables are read from, or nullptr if
+    // the program has no variables.
+    const Interpreter_Context* variables() const;
+
+private:
+    friend class Bytecode_Compiler;
+
+    std::vector<Instruction> code;
+    // Context the variables of the tree are read from (nullptr if the
+    // tree has no variables).
+    const Interpreter_Context* context;
+    std::size_t max_depth;
+    std::size_t temps;
+};
+
+#endif // BYTECODE_H
@@ -2,9 +2,16 @@
 #ifndef COMPONENT_NODE_H
 #define COMPONENT_NODE_H
 
+#include "Refcounted.h"
+#include <cstddef>
 #include <stdexcept>
 #include <string>
 
+// Build with ATOMIC_REFCOUNT=1 to share trees between threads.
+#ifndef ATOMIC_REFCOUNT
+#define ATOMIC_REFCOUNT 0
+#endif
+
 // Forward declaration.
 class Visitor;
 
@@ -17,12 +24,12 @@ class Visitor;
  *        Composite pattern.  The methods in this class are not
  *        defined as pure virtual so that subclasses in the Composite
  *        pattern don't have to implement methods they don't care
- *        about.
+ *        about.  Nodes count their own references (see Refcounted).
  *
  * @see   See Composite_Unary_Node and Composite_Binary_Node for nodes
  *        with right only and left and right children, respectively.
  */
-class Component_Node {
+class Component_Node : public Refcounted<ATOMIC_REFCOUNT> {
 public:
     // Dtor
     virtual ~Component_Node() = default;
@@ -39,6 +46,44 @@ public:
     // Accept a visitor to perform some action on the node's item
     // completely arbitrary visitor template
     virtual void accept(Visitor& visitor) const = 0;
+
+    // Return the number of nodes in the subtree rooted at this node.
+    // It is counted once, when the node is built, and a node with
+    // several parents is counted under each of them.
+    std::size_t size() const;
+
+    // Return the number of nodes on the longest path from this node
+    // down to a leaf, counted when the node is built.
+    std::size_t height() const;
+
+    // Return the node this one was first attached under, or nullptr.
+    const Component_Node* parent() const;
+
+    // Return true if every node below this one was attached under a
+    // single parent, so the subtree can be walked through parent()
+    // links instead of a stack.
+    bool threaded() const;
+
+protected:
+    // Ctor
+    Component_Node();
+
+    // Add the nodes under @a child to the size and height of this node
+    // and link @a child back to it.
+    void add_child(Component_Node* child);
+
+    // Unlink @a child from this node when this node goes away.
+    void remove_child(Component_Node* child);
+
+private:
+    // Number of nodes in the subtree, saturating instead of overflowing.
+    std::size_t nodes;
+    // Number of levels in the subtree.
+    std::size_t levels;
+    // First node this one was attached under, if still alive.
+    const Component_Node* parent_node;
+    // Do all parent links below this node lead back up to it?
+    bool linked;
 };
 
 #endif // COMPONENT_NODE_H
@@ -0,0 +1,103 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#ifndef COMPONENT_NODE_FACTORY_H
+#define COMPONENT_NODE_FACTORY_H
+
+#include <cstddef>
+#include <unordered_map>
+
+#include "Component_Node.h"
+#include "Refcounter.h"
+
+// Forward declarations.
+class Interpreter_Context;
+
+/**
+ * @class Component_Node_Factory
+ * @brief Creates the nodes of an expression tree for the Interpreter.
+ *
+ *        When sharing is turned on the factory hash-conses the nodes:
+ *        asking for a node that is structurally identical to one it
+ *        already made returns the existing node, so repeated
+ *        subexpressions such as the a+b in (a+b)*(a+b) are stored once
+ *        and the tree becomes a DAG.  Children are held through
+ *        Refcounter, which keeps a shared node alive for as long as any
+ *        parent refers to it.
+ */
+class Component_Node_Factory {
+public:
+    typedef Refcounter<Component_Node> Node;
+
+    // Constructor. When @a share is false every call makes a new node.
+    explicit Component_Node_Factory(bool share = false);
+
+    // Make a number leaf.
+    Node make_number(int value);
+
+    // Make a variable leaf for a slot of @a context.
+    Node make_variable(const Interpreter_Context& context, int slot);
+
+    // Make the unary operator nodes.
+    Node make_negate(const Node& right);
+    Node make_factorial(const Node& left);
+
+    // Make the binary operator nodes.
+    Node make_add(const Node& left, const Node& right);
+    Node make_subtract(const Node& left, const Node& right);
+    Node make_multiply(const Node& left, const Node& right);
+    Node make_divide(const Node& left, const Node& right);
+    Node make_modulus(const Node& left, const Node& right);
+    Node make_power(const Node& left, const Node& right);
+
+    // Return whether structurally identical nodes are shared.
+    bool sharing() const;
+
+    // Return the number of distinct nodes remembered for sharing since
+    // the last clear().
+    std::size_t size() const;
+
+    // Forget the nodes made so far. Trees that use them keep them alive.
+    void clear();
+
+private:
+    /**
+     * @struct Key
+     * @brief What makes two nodes structurally identical: the operator,
+     *        the value or slot of a leaf, and the (already shared)
+     *        children.
+     */
+    struct Key {
+        char op;
+        int value;
+        const Component_Node* left;
+        const Component_Node* right;
+
+        bool operator==(const Key& rhs) const;
+    };
+
+    /**
+     * @struct Key_Hash
+     * @brief Hash function for Key.
+     */
+    struct Key_Hash {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    // Return the node for @a key, or nullptr if there isn't one yet.
+    Node* find(const Key& key);
+
+    // Remember @a node under @a key if sharing is on, then return it.
+    Node add(const Key& key, Component_Node* node);
+
+    bool share;
+    // Every distinct node made since the last clear().
+    std::unordered_map<Key, Node, Key_Hash> nodes;
+};
+
+#endif // COMPONENT_NODE_FACTORY_H
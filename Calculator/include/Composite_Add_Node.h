@@ -17,7 +17,8 @@ class Visitor;
 class Composite_Add_Node : public Composite_Binary_Node {
 public:
     // Ctor
-    Composite_Add_Node(Component_Node* left, Component_Node* right);
+    Composite_Add_Node(
+        const Refcounter<Component_Node>& left, const Refcounter<Component_Node>& right);
 
     // Dtor
     ~Composite_Add_Node() override = default;
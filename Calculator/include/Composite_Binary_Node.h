@@ -11,17 +11,19 @@
 class Composite_Binary_Node : public Composite_Unary_Node {
 public:
     // Ctor
-    Composite_Binary_Node(Component_Node* left, Component_Node* right);
+    Composite_Binary_Node(
+        const Refcounter<Component_Node>& left, const Refcounter<Component_Node>& right);
 
     // Dtor
-    ~Composite_Binary_Node() override = default;
+    ~Composite_Binary_Node() override;
 
     // Return the left child.
     Component_Node* left() const override;
 
 private:
-    // left child
-    std::unique_ptr<Component_Node> leftChild;
+    // left child, which may be shared with other parents.
+    // Mutable so the const accessor can return a non-const pointer.
+    mutable Refcounter<Component_Node> leftChild;
 };
 
 #endif // COMPOSITE_BINARY_NODE_H
@@ -16,7 +16,8 @@ class Visitor;
 class Composite_Divide_Node : public Composite_Binary_Node {
 public:
     // Ctor
-    Composite_Divide_Node(Component_Node* left, Component_Node* right);
+    Composite_Divide_Node(
+        const Refcounter<Component_Node>& left, const Refcounter<Component_Node>& right);
 
     // Dtor
     ~Composite_Divide_Node() override = default;
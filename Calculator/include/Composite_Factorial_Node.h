@@ -20,7 +20,7 @@ class Visitor;
 class Composite_Factorial_Node : public Composite_Left_Node {
 public:
     // Ctor
-    Composite_Factorial_Node(Component_Node* right);
+    Composite_Factorial_Node(const Refcounter<Component_Node>& right);
 
     // Dtor
     ~Composite_Factorial_Node() override = default;
@@ -10,7 +10,7 @@
 #define COMPOSITE_LEFT_NODE_H
 
 #include "Component_Node.h"
-#include <memory>
+#include "Refcounter.h"
 
 /**
  * @class Composite_Left_Unary_Node
@@ -20,17 +20,18 @@
 class Composite_Left_Node : public Component_Node {
 public:
     // Ctor
-    explicit Composite_Left_Node(Component_Node* left);
+    explicit Composite_Left_Node(const Refcounter<Component_Node>& left);
 
     // Return the right child.
     Component_Node* left() const override;
 
     // Dtor
-    ~Composite_Left_Node() override = default;
+    ~Composite_Left_Node() override;
 
 private:
-    // Right child
-    std::unique_ptr<Component_Node> leftChild;
+    // Left child, which may be shared with other parents.
+    // Mutable so the const accessor can return a non-const pointer.
+    mutable Refcounter<Component_Node> leftChild;
 };
 
 #endif // COMPOSITE_LEFT_NODE_H
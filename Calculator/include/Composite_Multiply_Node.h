@@ -16,7 +16,8 @@ class Visitor;
 class Composite_Multiply_Node : public Composite_Binary_Node {
 public:
     // Ctor
-    Composite_Multiply_Node(Component_Node* left, Component_Node* right);
+    Composite_Multiply_Node(
+        const Refcounter<Component_Node>& left, const Refcounter<Component_Node>& right);
 
     // Dtor
     ~Composite_Multiply_Node() override = default;
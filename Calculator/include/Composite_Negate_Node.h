@@ -16,7 +16,7 @@ class Visitor;
 class Composite_Negate_Node : public Composite_Unary_Node {
 public:
     // Ctor
-    explicit Composite_Negate_Node(Component_Node* right);
+    explicit Composite_Negate_Node(const Refcounter<Component_Node>& right);
 
     // Dtor
     ~Composite_Negate_Node() override = default;
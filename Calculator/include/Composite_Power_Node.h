@@ -23,7 +23,8 @@ class Visitor;
 class Composite_Power_Node : public Composite_Binary_Node {
 public:
     // Ctor
-    Composite_Power_Node(Component_Node* left, Component_Node* right);
+    Composite_Power_Node(
+        const Refcounter<Component_Node>& left, const Refcounter<Component_Node>& right);
 
     // Dtor
     ~Composite_Power_Node() override = default;
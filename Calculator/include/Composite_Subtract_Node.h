@@ -16,7 +16,8 @@ class Visitor;
 class Composite_Subtract_Node : public Composite_Binary_Node {
 public:
     // Ctor
-    Composite_Subtract_Node(Component_Node* left, Component_Node* right);
+    Composite_Subtract_Node(
+        const Refcounter<Component_Node>& left, const Refcounter<Component_Node>& right);
 
     // Dtor
     ~Composite_Subtract_Node() override = default;
@@ -3,7 +3,7 @@
 #define COMPOSITE_UNARY_NODE_H
 
 #include "Component_Node.h"
-#include <memory>
+#include "Refcounter.h"
 
 /**
  * @class Composite_Unary_Node
@@ -14,17 +14,18 @@
 class Composite_Unary_Node : public Component_Node {
 public:
     // Ctor
-    explicit Composite_Unary_Node(Component_Node* right);
+    explicit Composite_Unary_Node(const Refcounter<Component_Node>& right);
 
     // Return the right child.
     Component_Node* right() const override;
 
     // Dtor
-    ~Composite_Unary_Node() override = default;
+    ~Composite_Unary_Node() override;
 
 private:
-    // Right child
-    std::unique_ptr<Component_Node> rightChild;
+    // Right child, which may be shared with other parents.
+    // Mutable so the const accessor can return a non-const pointer.
+    mutable Refcounter<Component_Node> rightChild;
 };
 
 #endif // COMPOSITE_UNARY_NODE_H
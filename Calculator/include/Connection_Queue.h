@@ -0,0 +1,57 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#ifndef CONNECTION_QUEUE_H
+#define CONNECTION_QUEUE_H
+
+#include "BQueue.h"
+#include "Event_Handler.h"
+#include <cstddef>
+
+/**
+ * @class Connection_Queue
+ * @brief Hands connections accepted on one event loop to the event
+ *        loop of another thread, which serves them.
+ *
+ *        The accepting thread puts each connection on a single-producer,
+ *        single-consumer BQueue and wakes the serving reactor through
+ *        an eventfd, which is the handle this handler is registered
+ *        with.  The serving thread then takes every connection that is
+ *        waiting and registers an @a Expression_Tree_Event_Handler for
+ *        each on its own reactor.
+ */
+class Connection_Queue : public Event_Handler {
+public:
+    // Room for @a size connections waiting to be served.  Throws
+    // std::domain_error if the eventfd can't be made.
+    explicit Connection_Queue(std::size_t size);
+
+    // Close the eventfd and the connections that are still waiting.
+    virtual ~Connection_Queue();
+
+    // Hand @a connection to the serving thread.  Only one thread may
+    // call this.  Returns false, and leaves the connection to the
+    // caller, if the queue is full.
+    bool hand_off(int connection);
+
+    // Returns the eventfd.
+    virtual int get_handle() const;
+
+    // Serve every connection that is waiting.
+    virtual void handle_input();
+
+private:
+    // The connections that haven't been served yet.
+    BQueue<int, true> connections;
+
+    // Written by hand_off() after each connection, so the serving
+    // reactor wakes up.
+    int handle;
+};
+
+#endif // CONNECTION_QUEUE_H
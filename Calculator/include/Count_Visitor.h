@@ -16,6 +16,9 @@ public:
     // Visits a Leaf_Node
     void visit(const Leaf_Node& node) override;
 
+    // Visits a Variable_Node
+    void visit(const Variable_Node& node) override;
+
     // Visit a Composite_Negate_Node
     void visit(const Composite_Negate_Node& node) override;
 
@@ -2,8 +2,10 @@
 #ifndef EVALUATION_VISITOR_H
 #define EVALUATION_VISITOR_H
 
+#include "AStack.h"
 #include "Visitor.h"
-#include <stack>
+#include <cstddef>
+#include <iostream>
 
 // forward declarations of nodes
 // solves circular include problem
@@ -27,9 +29,15 @@ class Composite_Factorial_Node;
  */
 class Evaluation_Visitor : public Visitor {
 public:
+    // Division and modulus by zero are reported on @a errors.
+    explicit Evaluation_Visitor(std::ostream& errors = std::cout);
+
     // Visit a Leaf_Node.
     void visit(const Leaf_Node& node) override;
 
+    // Visit a Variable_Node.
+    void visit(const Variable_Node& node) override;
+
     // Visit a Composite_Negate_Node.
     void visit(const Composite_Negate_Node& node) override;
 
@@ -60,9 +68,18 @@ public:
     // Resets the evaluation to it can be reused.
     void reset();
 
+    // Push a value that has already been evaluated.
+    void push(int value);
+
+    // Return the number of values on the stack.
+    std::size_t size() const;
+
 private:
     // Stack used for temporarily storing evaluations.
-    std::stack<int> stack;
+    AStack<int> stack;
+
+    // Where errors are reported.
+    std::ostream& errors;
 };
 
 #endif // EVALUATION_VISITOR_H
@@ -17,8 +17,24 @@ public:
     // Destructor can be made private to ensure dynamic allocation.
     virtual ~Event_Handler() = default;
 
-    // Called back by the Reactor when input events occur.
+    // Returns the I/O handle the Reactor waits on, or -1 if the handler
+    // only has timers.
+    virtual int get_handle() const = 0;
+
+    // Called back by the Reactor once the handler is registered.
+    virtual void handle_open() {}
+
+    // Called back by the Reactor when input events occur.  Events are
+    // edge-triggered, so the handler reads until the handle would
+    // block.
     virtual void handle_input() = 0;
+
+    // Called back by the Reactor when output that would have blocked
+    // can be written again.
+    virtual void handle_output() {}
+
+    // Called back by the Reactor when a timer of the handler expires.
+    virtual void handle_timeout(long /* timer_id */) {}
 };
 
 #endif // EVENT_HANDLER_H
@@ -4,10 +4,15 @@
 
 #include "Component_Node.h"
 #include "Refcounter.h"
+#include <memory>
 #include <stdexcept>
 #include <string>
 
 // Forward declarations.
+class Bytecode;
+class Flat_Tree;
+class Native_Code;
+
 class Expression_Tree_Iterator;
 
 class Expression_Tree_Const_Iterator;
@@ -46,6 +51,9 @@ public:
     // expression tree.
     explicit Expression_Tree(Component_Node* root, bool increase_count = false);
 
+    // Ctor that shares a root that is already reference counted.
+    explicit Expression_Tree(const Refcounter<Component_Node>& root);
+
     // Copy ctor
     Expression_Tree(const Expression_Tree& t);
 
@@ -53,6 +61,9 @@ public:
     // to the iterators.
     Component_Node* get_root();
 
+    // Gain const access to the underlying root pointer.
+    const Component_Node* get_root() const;
+
     // Assignment operator.
     Expression_Tree& operator=(const Expression_Tree& t);
 
@@ -92,10 +103,32 @@ public:
     // Accept a visitor to perform some action on the Expression_Tree.
     void accept(Visitor& visitor) const;
 
+    // Return the tree compiled to bytecode. It is compiled the first
+    // time it is asked for and shared by copies of the tree. The tree
+    // must not be null.
+    const Bytecode& bytecode() const;
+
+    // Return the tree compiled to machine code, compiling it the first
+    // time. Check Native_Code::valid() before running it.
+    const Native_Code& native_code() const;
+
+    // Return the tree stored as flat arrays, flattening it the first
+    // time. The tree must not be null.
+    const Flat_Tree& flat() const;
+
 private:
     // Pointer to actual implementation, i.e., the "bridge", which is
     // reference counted to automate memory management.
     Refcounter<Component_Node> root;
+
+    // Compiled form of the tree, if it has been compiled yet.
+    mutable std::shared_ptr<const Bytecode> code;
+
+    // Machine code translated from @a code, if it has been yet.
+    mutable std::shared_ptr<const Native_Code> native;
+
+    // Flat copy of the tree, if it has been made yet.
+    mutable std::shared_ptr<const Flat_Tree> flat_tree;
 };
 
 #endif // EXPRESSION_TREE_H
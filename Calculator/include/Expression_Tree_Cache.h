@@ -0,0 +1,95 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#ifndef EXPRESSION_TREE_CACHE_H
+#define EXPRESSION_TREE_CACHE_H
+
+#include <cstddef>
+#include <list>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "Expression_Tree.h"
+
+/**
+ * @class Expression_Tree_Cache
+ * @brief Bounded least-recently-used cache of built expression trees,
+ *        keyed by the normalized text of the expression.
+ *
+ *        Trees read their variables from the Interpreter_Context when
+ *        they are evaluated, and the slots they read never change, so
+ *        no change to the variables makes a cached tree stale.
+ */
+class Expression_Tree_Cache {
+public:
+    // Constructor. A capacity of 0 turns the cache off.
+    explicit Expression_Tree_Cache(std::size_t capacity);
+
+    // Return the key for an expression: its tokens separated by single
+    // spaces, so differences in whitespace don't matter.  Returns an
+    // empty string for input that can't be tokenized.
+    static std::string normalize(std::string_view expression);
+
+    // Build the key for an expression in @a key, reusing its storage.
+    static void normalize(std::string_view expression, std::string& key);
+
+    // Look up @a key. On a hit the entry becomes the most recently used
+    // one and its tree is returned, else nullptr.  The tree stays valid
+    // until the cache changes.
+    const Expression_Tree* find(const std::string& key);
+
+    // Add a tree, evicting the least recently used entry if the cache
+    // is full.  Returns the cached tree, or nullptr if it isn't cached.
+    const Expression_Tree* insert(const std::string& key, const Expression_Tree& tree);
+
+    // Remove every entry.
+    void clear();
+
+    // Return the number of entries.
+    std::size_t size() const;
+
+    // Return the maximum number of entries.
+    std::size_t capacity() const;
+
+    // Return the number of lookups that found a tree.
+    std::size_t hits() const;
+
+    // Return the number of lookups that didn't find a tree.
+    std::size_t misses() const;
+
+    // Return the number of entries evicted to make room.
+    std::size_t evictions() const;
+
+    // Print the counters.
+    void print(std::ostream& out) const;
+
+private:
+    /**
+     * @struct Entry
+     * @brief A cached tree and the key it was stored under.
+     */
+    struct Entry {
+        std::string key;
+        Expression_Tree tree;
+    };
+
+    // Entries, most recently used first.
+    std::list<Entry> entries;
+    // Key of each entry. The views point into the keys in @a entries.
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+
+    std::size_t max_size;
+
+    std::size_t hit_count;
+    std::size_t miss_count;
+    std::size_t eviction_count;
+};
+
+#endif // EXPRESSION_TREE_CACHE_H
@@ -66,6 +66,10 @@ public:
 
     Expression_Tree_Command make_history_command(const std::string&);
 
+    // Make the requested stats command.  This method is used in the
+    // implementation of the various commands.
+    Expression_Tree_Command make_stats_command(const std::string&);
+
     // Make the requested eval command.  This method is used in the
     // implementation of the various commands.
     Expression_Tree_Command make_eval_command(const std::string&);
@@ -72,6 +72,10 @@ public:
 
     virtual Expression_Tree_Command make_history_command(const std::string&) = 0;
 
+    // Make the requested stats command.  This method is used in the
+    // implementation of the various commands.
+    virtual Expression_Tree_Command make_stats_command(const std::string&) = 0;
+
     // Make the requested quit command.  This method is used in the
     // implementation of the various commands.
     virtual Expression_Tree_Command make_quit_command(const std::string&) = 0;
@@ -131,6 +135,10 @@ public:
 
     virtual Expression_Tree_Command make_history_command(const std::string&);
 
+    // Make the requested stats command.  This method is used in the
+    // implementation of the various commands.
+    virtual Expression_Tree_Command make_stats_command(const std::string&);
+
     // Make the requested quit command.  This method is used in the
     // implementation of the various commands.
     virtual Expression_Tree_Command make_quit_command(const std::string&);
@@ -185,6 +185,20 @@ public:
     bool execute() override;
 };
 
+/**
+ * @class Stats_Command
+ * @brief Prints the expression cache counters in verbose mode.
+ */
+class Stats_Command : public Expression_Tree_Command_Impl {
+public:
+    // Constructor that provides the appropriate @a
+    // Expression_Tree_Context.
+    explicit Stats_Command(Expression_Tree_Context& context);
+
+    // Print the counters.
+    bool execute() override;
+};
+
 /**
  * @class Quit_Command
  * @brief Instructs the event loop to shut down.
@@ -9,13 +9,17 @@
 #ifndef TREE_CONTEXT_H
 #define TREE_CONTEXT_H
 
+#include <iostream>
 #include <memory>
 #include <string>
+#include <typeinfo>
 
 #include "Expression_Tree.h"
+#include "Expression_Tree_Cache.h"
 #include "Expression_Tree_State.h"
 #include "Interpreter.h"
 #include "LQueue.h"
+#include "Thread_Pool.h"
 
 /**
  * @class Expression_Tree_Context
@@ -28,8 +32,8 @@
  */
 class Expression_Tree_Context {
 public:
-    // Constructor.
-    Expression_Tree_Context();
+    // Constructor.  The output of the commands goes to @a output.
+    explicit Expression_Tree_Context(std::ostream& output = std::cout);
 
     // Set the desired format to the designated new_format.
     void format(const std::string& new_format);
@@ -46,6 +50,12 @@ public:
     // tree using the designated format.
     void evaluate(const std::string& format);
 
+    // Format in-order, make the tree of @a expression and evaluate it
+    // post-order, like the succinct macro command, and report a
+    // std::domain_error the way it does.  No commands are made, and a
+    // state is only made if the context isn't in it already.
+    void evaluate_expression(const std::string& expression);
+
     void make_set(const std::string& expression);
 
     // Set the value of the variable
@@ -58,6 +68,9 @@ public:
 
     void history();
 
+    // Print the expression cache counters.
+    void stats();
+
     // Return a pointer to the current Expression_Tree_State.
     Expression_Tree_State* state() const;
 
@@ -65,6 +78,9 @@ public:
     // new_state pointer.
     void state(Expression_Tree_State* new_state);
 
+    // Return the stream the output of the commands goes to.
+    std::ostream& out();
+
     // Return a reference to the current Expression_Tree.
     Expression_Tree& tree();
 
@@ -79,6 +95,9 @@ public:
 
     void addToCommands(const std::string& input);
 
+    // Add @a input to the history without copying it.
+    void addToCommands(std::string&& input);
+
     // Persistent interpreter context for variables. Our interpreter
     // will change values insilde of this, so I just stuck the variable
     // in the public section.
@@ -89,7 +108,28 @@ public:
         return isSet;
     }
 
+    // Parser reused by every expr command.
+    Interpreter interpreter;
+
+    // Trees built from recent expressions.
+    Expression_Tree_Cache cache;
+
+    // Storage for the cache key of each expression.
+    std::string cache_key;
+
+    // Return the pool that splits the evaluation of large trees with
+    // -f.  It is started the first time it's needed and stopped with
+    // the context.
+    Thread_Pool& fork_join_pool();
+
 private:
+    // Make @a State the current state unless it is already.
+    template <typename State> void enter_state()
+    {
+        if (typeid(*treeState) != typeid(State))
+            treeState.reset(new State);
+    }
+
     // Keep track of the current state that we're in.  We use an @a
     // std::unique_ptr to simplify memory management and avoid memory leaks.
     std::unique_ptr<Expression_Tree_State> treeState;
@@ -98,6 +138,10 @@ private:
     bool isFormatted;
     bool isSet;
     LQueue<std::string> commands;
+    // Where the output of the commands goes.
+    std::ostream& output;
+    // The pool returned by fork_join_pool(), or null until then.
+    std::unique_ptr<Thread_Pool> fork_join;
 };
 
 #endif // TREE_CONTEXT
@@ -5,6 +5,11 @@
 #include "Event_Handler.h"
 #include "Expression_Tree_Command_Factory.h"
 #include "Expression_Tree_Context.h"
+#include "Output_Buffer.h"
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <unistd.h>
 
 /**
  * @class Expression_Tree_Event_Handler
@@ -14,38 +19,77 @@
  *        This class plays the role of "event handler" in the Reactor
  *        pattern and defines methods for use in the Template Method
  *        pattern that is used to process user input commands.
+ *        Commands read from standard input write to std::cout and end
+ *        the event loop when they're done.  Commands read from a
+ *        connection write to a buffer that is sent back in one write,
+ *        and close the connection when they're done.
+ *
+ *        A framed connection sends batches of commands instead of
+ *        lines.  Every frame is a 4-byte big-endian length followed
+ *        by that many bytes of commands, each of which is again a
+ *        4-byte length followed by the command.  The commands of a
+ *        batch run back to back, and their results come back in one
+ *        frame of the same form, with one result per command that ran,
+ *        in one write.  A batch stops after a quit command.
  *
  * @see   Verbose_Expression_Tree_Event_Handler and
  *        Macro_Command_Expression_Tree_Event_Handler.
  */
 class Expression_Tree_Event_Handler : public Event_Handler {
 public:
-    // Constructor.
-    Expression_Tree_Event_Handler();
+    // Constructor.  Commands are read from @a handle, which the
+    // handler owns unless it's standard input, in frames if @a framed
+    // is true or else in lines.
+    Expression_Tree_Event_Handler(int handle, bool framed);
 
     // Dtor.
-    virtual ~Expression_Tree_Event_Handler() = default;
+    virtual ~Expression_Tree_Event_Handler();
 
     // Factory that creates the appropriate subclass of @a
     // Expression_Tree_Event_Handler, i.e., @a
     // Verbose_Expression_Tree_Event_Handler or @a
-    // Macro_Command_Expression_Tree_Event_Handler.
-    static Expression_Tree_Event_Handler* make_handler(bool verbose);
+    // Macro_Command_Expression_Tree_Event_Handler, that reads commands
+    // from @a handle, in frames if @a framed is true.
+    static Expression_Tree_Event_Handler* make_handler(
+        bool verbose, int handle = STDIN_FILENO, bool framed = false);
+
+    // Returns the handle the commands are read from.
+    virtual int get_handle() const;
+
+    // This method is called back by the reactor once the handler is
+    // registered, and prompts the user for the first command.
+    virtual void handle_open();
 
     // This method is called back by the reactor when input is
     // available.  It is a template method that performs the sequence
     // of steps associated with processing expression tree application
-    // commands.
+    // commands, for every complete line that has arrived.
     virtual void handle_input();
 
+    // This method is called back by the reactor when a connection can
+    // take the rest of the output, and goes on with the input.
+    virtual void handle_output();
+
+    // This method is called back by the reactor when a closing
+    // connection has waited long enough for the client.
+    virtual void handle_timeout(long timer_id);
+
 protected:
     // This hook method is a placeholder for prompting the user for
     // input.
     virtual void prompt_user() = 0;
 
-    // This hook method gets user input.
+    // This hook method gets the next line of user input.  Returns false
+    // if no complete line has arrived yet or the input has ended.
     virtual bool get_input(std::string& user_input);
 
+    // Make and execute the command for one line of user input.
+    virtual void handle_command(const std::string& user_input);
+
+    // Stop reading commands.  The event loop ends if they came from
+    // standard input.
+    void finish();
+
     // This hook method is a placeholder for making a command based on
     // the user input.
     virtual Expression_Tree_Command make_command(const std::string& user_input) = 0;
@@ -53,6 +97,11 @@ protected:
     // This hook method executes a command.
     virtual bool execute_command(Expression_Tree_Command& command);
 
+    // Output of the commands from a connection that hasn't been sent
+    // yet, and the stream the commands write to.
+    Output_Buffer output_buffer;
+    std::ostream output;
+
     // The context where the expression tree state resides.
     Expression_Tree_Context tree_context;
 
@@ -61,6 +110,58 @@ protected:
 
     // Handle to last valid command that was executed.
     Expression_Tree_Command last_valid_command;
+
+private:
+    // Handle the lines or the batches of commands that have arrived.
+    // Returns false if the output has to be sent before more input is
+    // handled.
+    bool handle_lines();
+    bool handle_batches();
+
+    // Run the commands of the batch in [@a body, @a body + @a length)
+    // and write a frame with their results.  Throws std::domain_error
+    // if the batch isn't framed properly.
+    void handle_batch(const char* body, std::size_t length);
+
+    // Get the body of the next frame of input.  Returns false if no
+    // complete frame has arrived yet or the input has ended, and
+    // throws std::domain_error if the frame is too large.
+    bool get_frame(const char*& body, std::size_t& length);
+
+    // Read more input after what hasn't been handled yet, asking for
+    // more than usual if @a wanted bytes are still to come.  Returns
+    // false if the read would block.
+    bool read_input(std::string::size_type wanted);
+
+    // Flush the output, and send as much of it as the connection
+    // takes.  Returns false if some of it has to wait for
+    // handle_output().
+    bool flush_output();
+
+    // Close a connection once its output has been sent.  The rest of
+    // its input is read and dropped until the client closes its end,
+    // since closing with input unread would reset the connection and
+    // could lose the output on its way.
+    void close_connection();
+
+    // The handle the commands are read from, whether it's standard
+    // input, whether the handler opened it itself, and whether the
+    // commands come in frames.
+    int handle;
+    bool console;
+    bool owns_handle;
+    bool framed;
+
+    // Input that has been read but not yet handled, starting at start.
+    // The buffer is reused for every read.
+    std::string buffer;
+    std::string::size_type start;
+
+    // Has the input ended, have we stopped handling it, and are we
+    // waiting for the client to close?
+    bool closed;
+    bool done;
+    bool lingering;
 };
 
 /**
@@ -75,7 +176,7 @@ protected:
 class Verbose_Expression_Tree_Event_Handler : public Expression_Tree_Event_Handler {
 public:
     // Constructor.
-    Verbose_Expression_Tree_Event_Handler();
+    Verbose_Expression_Tree_Event_Handler(int handle, bool framed);
 
     // Dtor.
     virtual ~Verbose_Expression_Tree_Event_Handler() = default;
@@ -105,7 +206,7 @@ private:
 class Macro_Command_Expression_Tree_Event_Handler : public Expression_Tree_Event_Handler {
 public:
     // Constructor.
-    Macro_Command_Expression_Tree_Event_Handler() = default;
+    Macro_Command_Expression_Tree_Event_Handler(int handle, bool framed);
 
     // Dtor.
     virtual ~Macro_Command_Expression_Tree_Event_Handler() = default;
@@ -114,6 +215,10 @@ protected:
     // This hook method less verbosely prompts the user for input.
     virtual void prompt_user();
 
+    // Evaluate a line of user input as the macro command would, but
+    // without making it.  The end of input still makes a command.
+    virtual void handle_command(const std::string& user_input);
+
     // This hook method makes the appropriate set of macro commands
     // based on the user input.
     virtual Expression_Tree_Command make_command(const std::string& user_input);
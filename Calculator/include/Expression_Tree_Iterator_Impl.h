@@ -2,11 +2,12 @@
 #ifndef TREE_ITERATOR_IMPL_H
 #define TREE_ITERATOR_IMPL_H
 
+#include "AStack.h"
 #include "Expression_Tree.h"
 #include <cstdlib>
 #include <queue>
-#include <stack>
 #include <stdexcept>
+#include <utility>
 
 // Solve circular include problem
 
@@ -124,7 +125,7 @@ public:
 
 private:
     // Our current position in the iteration.
-    std::stack<Expression_Tree> stack;
+    AStack<Expression_Tree> stack;
 };
 
 /**
@@ -177,7 +178,7 @@ public:
 
 private:
     // Our current position in the iteration.
-    std::stack<Expression_Tree> stack;
+    AStack<Expression_Tree> stack;
 };
 
 /**
@@ -229,8 +230,15 @@ public:
     typedef int difference_type;
 
 private:
-    // Our current position in the iteration.
-    std::stack<Expression_Tree> stack;
+    // Push the children of the top of the stack until the top is a
+    // node whose children have all been visited.
+    void descend();
+
+    // Our current position in the iteration. Each node is paired with
+    // whether its children have been pushed yet. Comparing the top with
+    // its parent's children isn't enough once subtrees are shared,
+    // since a node can then be its own sibling.
+    AStack<std::pair<Expression_Tree, bool>> stack;
 };
 
 /**
@@ -0,0 +1,85 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#ifndef EXPRESSION_TREE_SERVER_H
+#define EXPRESSION_TREE_SERVER_H
+
+#include "Event_Handler.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Forward declaration.
+class Connection_Queue;
+
+/**
+ * @class Expression_Tree_Server
+ * @brief Accepts connections from clients and registers an @a
+ *        Expression_Tree_Event_Handler for each, so every connection
+ *        has its own context and reads the same commands as standard
+ *        input.
+ *
+ *        This class plays the role of "acceptor" in the Reactor
+ *        pattern, and of "prototype" in the Prototype pattern, so
+ *        every event loop can have a TCP server listening on the same
+ *        port.  A Unix socket can't be shared that way, so one server
+ *        accepts its connections and hands them to the other event
+ *        loops through their @a Connection_Queue.
+ */
+class Expression_Tree_Server : public Event_Handler {
+public:
+    // Listen on @a address, a Unix socket path or a loopback
+    // [host:]port.  Throws std::domain_error if it can't, or if the
+    // host isn't in 127.0.0.0/8.
+    explicit Expression_Tree_Server(const std::string& address);
+
+    // Stop listening.
+    virtual ~Expression_Tree_Server();
+
+    // Make a server for another event loop that listens on the same
+    // address.  Throws std::domain_error if it can't, or if the
+    // address is a Unix socket.
+    Expression_Tree_Server* clone() const;
+
+    // Can clone() make servers for other event loops?
+    bool reuses_port() const;
+
+    // Serve the connections it accepts in turn with this event loop
+    // and those of @a queues, which must outlive the server.  A
+    // connection whose queue is full is served here.
+    void hand_off(const std::vector<Connection_Queue*>& queues);
+
+    // Returns the listening socket.
+    virtual int get_handle() const;
+
+    // Accept every pending connection.
+    virtual void handle_input();
+
+private:
+    // Serve @a connection with this event loop.
+    void serve(int connection);
+
+    // The listening socket.
+    int handle;
+
+    // Is it a TCP socket?
+    bool tcp;
+
+    // The address, with the port that was picked if it was 0.
+    std::string address;
+
+    // Path of the Unix socket, which the server removes when it stops.
+    std::string path;
+
+    // The event loops connections are handed to, and the turn of the
+    // next one, where 0 is this event loop.
+    std::vector<Connection_Queue*> queues;
+    std::size_t turn;
+};
+
+#endif // EXPRESSION_TREE_SERVER_H
@@ -14,6 +14,7 @@
 #include <string>
 
 // Forward declaration.
+class Component_Node;
 class Expression_Tree_Context;
 
 /**
@@ -67,10 +68,15 @@ public:
     static void print_tree(
         const Expression_Tree& tree, const std::string& traversal_order, std::ostream& os);
 
-    // Evaluate and print the yield of the tree to the @os in the
-    // designated traversal_order.
-    static void evaluate_tree(
-        const Expression_Tree& tree, const std::string& traversal_order, std::ostream& os);
+    // Evaluate and print the yield of the tree to the output of @a
+    // context in the designated traversal_order.
+    static void evaluate_tree(Expression_Tree_Context& context, const Expression_Tree& tree,
+        const std::string& traversal_order);
+
+    // Evaluate a tree whose subtrees may be shared, visiting every
+    // distinct node once and reusing its value for the other parents.
+    // Division by zero is reported on @a os.
+    static int evaluate_shared_tree(const Component_Node* root, std::ostream& os);
 };
 
 /**
@@ -230,6 +236,13 @@ public:
 
     // Print the list of valid command if the user is in this state
     void print_valid_commands(Expression_Tree_Context& context) const override;
+
+    // Make the tree of the expression the tree of the @a context,
+    // reusing a cached tree if there is one, without changing the
+    // state.  Returns the cached tree if it's cached, so what's built
+    // to evaluate it is kept for the next time, else the new tree.
+    static const Expression_Tree& build_tree(
+        Expression_Tree_Context& context, const std::string& expression);
 };
 
 /**
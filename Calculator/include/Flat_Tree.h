@@ -0,0 +1,121 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#ifndef FLAT_TREE_H
+#define FLAT_TREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+
+// Forward declarations.
+class Component_Node;
+class Flat_Visitor;
+class Interpreter_Context;
+
+/**
+ * @class Flat_Tree
+ * @brief An expression tree stored as parallel arrays instead of linked
+ *        node objects.
+ *
+ *        Node i has a kind, the indices of its left and right children,
+ *        and a value (the number, or the slot of a variable).  All four
+ *        arrays share one allocation and the nodes are in post-order,
+ *        so the root is the last node and a node's children always come
+ *        before it.  A node shared by several parents is stored once.
+ *        A node takes 13 bytes.  A Component_Node and the Refcounter
+ *        Shims pointing at it take several times that.
+ */
+class Flat_Tree {
+public:
+    // The kinds of node.
+    enum Kind : std::uint8_t {
+        NUMBER,
+        VARIABLE,
+        NEGATE, // right child only
+        FACTORIAL, // left child only
+        ADD,
+        SUBTRACT,
+        MULTIPLY,
+        DIVIDE,
+        MODULUS,
+        POWER
+    };
+
+    // Index of a missing child.
+    static constexpr std::uint32_t none = 0xffffffff;
+
+    // Flatten the tree rooted at @a root, which must not be null.
+    explicit Flat_Tree(const Component_Node* root);
+
+    Flat_Tree(const Flat_Tree&) = delete;
+    Flat_Tree& operator=(const Flat_Tree&) = delete;
+
+    // Return the number of nodes.
+    std::size_t size() const;
+
+    // Return the number of bytes the nodes take.
+    std::size_t bytes() const;
+
+    // Return the index of the root.
+    std::uint32_t root() const;
+
+    // Return the kind of @a node.
+    Kind kind(std::uint32_t node) const
+    {
+        return kinds[node];
+    }
+
+    // Return the left child of @a node, or none.
+    std::uint32_t left(std::uint32_t node) const
+    {
+        return lefts[node];
+    }
+
+    // Return the right child of @a node, or none.
+    std::uint32_t right(std::uint32_t node) const
+    {
+        return rights[node];
+    }
+
+    // Return the item of @a node: its number, or the current value of
+    // its variable.
+    int item(std::uint32_t node) const;
+
+    // Visit every node in @a traversal_order ("in-order", "pre-order",
+    // "post-order" or "level-order").  Shared nodes are visited once
+    // per parent, like the Expression_Tree iterators do.  Throws
+    // Expression_Tree::Invalid_Iterator for any other order.
+    void traverse(const std::string& traversal_order, Flat_Visitor& visitor) const;
+
+    // Print the nodes in @a traversal_order the way Print_Visitor does.
+    void print(const std::string& traversal_order, std::ostream& out) const;
+
+    // Evaluate the tree and store its value in @a result.  Returns false
+    // without a result on division or modulus by zero, like
+    // Bytecode::evaluate().
+    bool evaluate(int& result) const;
+
+private:
+    friend class Flat_Tree_Builder;
+
+    std::size_t count;
+    // One allocation holding the four arrays below.
+    std::unique_ptr<unsigned char[]> storage;
+    int* values;
+    std::uint32_t* lefts;
+    std::uint32_t* rights;
+    Kind* kinds;
+    // Context the variables are read from (nullptr if the tree has no
+    // variables).
+    const Interpreter_Context* context;
+};
+
+#endif // FLAT_TREE_H
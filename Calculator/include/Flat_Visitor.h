@@ -0,0 +1,34 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#ifndef FLAT_VISITOR_H
+#define FLAT_VISITOR_H
+
+#include <cstdint>
+
+// Forward declaration.
+class Flat_Tree;
+
+/**
+ * @class Flat_Visitor
+ * @brief Abstract base class for visitors to the nodes of a Flat_Tree.
+ *
+ *        A flat node is an index into the arrays of its tree rather than
+ *        an object, so there is one visit() that looks at the kind of
+ *        the node instead of one per node class like Visitor has.
+ */
+class Flat_Visitor {
+public:
+    // Visit node @a node of @a tree.
+    virtual void visit(const Flat_Tree& tree, std::uint32_t node) = 0;
+
+    // No-op destructor to hold things together.
+    virtual ~Flat_Visitor() = default;
+};
+
+#endif // FLAT_VISITOR_H
@@ -11,10 +11,15 @@
 #ifndef INTERPRETER_H
 #define INTERPRETER_H
 
-#include <list>
-#include <map>
+#include <cstddef>
+#include <iostream>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
+#include "Arena.h"
+#include "Component_Node_Factory.h"
 #include "Expression_Tree.h"
 
 // Forward declaration.
@@ -25,27 +30,65 @@ class Symbol;
  * @brief This class stores variables and their values for use by the
  * Interpreters.
  *        This class plays the role of the "context" in the Interpreter pattern.
+ *
+ *        Variable names are interned into dense integer slots the first
+ *        time they are seen, and the values of all slots live in one
+ *        contiguous array.  Expression trees keep slots, so evaluating a
+ *        variable is an array index and setting many variables at once
+ *        is a single memcpy.
  */
 class Interpreter_Context {
 public:
     // Constructor.
-    Interpreter_Context() = default;
+    Interpreter_Context();
     // Destructor.
     ~Interpreter_Context() = default;
-    // Return whether the key exists.
-    bool exist(std::string variable);
-    // Return the value of a variable.
-    int get(std::string variable);
+    // Return whether the variable has been set.
+    bool exist(std::string_view variable) const;
+    // Return the value of a variable (0 if it was never set).
+    int get(std::string_view variable) const;
+    // Return the value stored in a slot.
+    int get(int slot) const
+    {
+        return values[slot];
+    }
     // Set the value of a variable.
-    void set(std::string variable, int value);
-    // Print all variables and their values.
-    void print();
-    // Clear all variables and their values.
-    void reset();
+    void set(std::string_view variable, int value);
+    // Copy @a count values into the slots starting at @a first_slot and
+    // mark them as set.
+    void set(int first_slot, const int* new_values, std::size_t count);
+    // Return the slot that holds a variable, giving the variable a slot
+    // (with no value set) if it doesn't have one yet. Slots never
+    // change, so expression trees can keep them.
+    int slot(std::string_view variable);
+    // Return the slot of a variable, or -1 if it doesn't have one.
+    int find(std::string_view variable) const;
+    // Return the name of the variable in a slot.
+    const std::string& name(int slot) const;
+    // Return the number of slots.
+    int size() const;
+    // Return the values of all slots.
+    const int* data() const;
+    // Print all variables that have been set and their values to @a
+    // out.
+    void print(std::ostream& out);
 
 private:
-    // Hash table containing variable names and values.
-    std::map<std::string, int> map;
+    // Return the bucket where @a variable is, or the empty bucket where
+    // it would go.
+    std::size_t bucket(std::string_view variable) const;
+    // Double the number of buckets and rehash the names.
+    void grow();
+
+    // Open addressing hash table of slots, -1 marks an empty bucket.
+    // The number of buckets is a power of two.
+    std::vector<int> buckets;
+    // Name of each slot.
+    std::vector<std::string> names;
+    // Value of each slot.
+    std::vector<int> values;
+    // Whether each slot has been set.
+    std::vector<char> bound;
 };
 
 /**
@@ -59,8 +102,10 @@ private:
  */
 class Interpreter {
 public:
-    // Constructor.
-    Interpreter() = default;
+    // Constructor. When @a share is true, structurally identical
+    // subexpressions are built as one shared node.  Errors found while
+    // building a tree are reported on @a errors.
+    explicit Interpreter(bool share = false, std::ostream& errors = std::cout);
     // destructor
     virtual ~Interpreter() = default;
     // Converts a string and context into a parse tree, and builds an
@@ -75,25 +120,39 @@ public:
     static bool is_alphanumeric(char input);
 
 private:
-    // Main interpreter loop.
-    void main_loop(Interpreter_Context& context, const std::string& input,
-        std::string::size_type& i, Symbol*& lastValidInput, bool& handled,
-        int& accumulated_precedence, std::list<Symbol*>& list);
-    // Inserts a terminal into the parse tree.
-    void terminal_insert(Symbol* op, std::list<Symbol*>& list);
-    // Inserts a variable (leaf node / number) into the parse tree.
-    void variable_insert(Interpreter_Context& context, const std::string& input,
-        std::string::size_type& i, int& accumulated_precedence, std::list<Symbol*>& list,
-        Symbol*& lastValidInput);
-    // Inserts a leaf node / number into the parse tree.
-    void number_insert(const std::string& input, std::string::size_type& i,
-        int& accumulated_precedence, std::list<Symbol*>& list, Symbol*& lastValidInput);
-    // Inserts a multiplication or division into the parse tree.
-    void precedence_insert(Symbol* op, std::list<Symbol*>& list);
-    // Process parenthesized expressions properly.
-    void handle_parenthesis(Interpreter_Context& context, const std::string& input,
-        std::string::size_type& i, Symbol*& lastValidInput, bool& handled,
-        int& accumulated_precedence, std::list<Symbol*>& list);
+    // Reduces the operator on top of the operator stack by moving its
+    // operands off the operand stack and pushing the result back on.
+    void reduce();
+    // Reduces every pending operator whose precedence is at least
+    // @a precedence, stopping at an open parenthesis.
+    void reduce_while(int precedence);
+    // Makes a variable leaf node out of a variable name.
+    Symbol* variable_insert(Interpreter_Context& context, std::string_view name);
+    // Makes a leaf node / number out of a run of digits.
+    Symbol* number_insert(std::string_view digits);
+    // Builds the expression tree for the parse tree under @a root.  It
+    // walks the parse tree in post-order with an explicit stack, so
+    // the depth of the tree is only limited by memory.
+    Component_Node_Factory::Node build(Symbol* root);
+
+    // Owns every Symbol of the parse tree that is being built.
+    Arena arena;
+    // Makes the nodes of the expression tree.
+    Component_Node_Factory factory;
+
+    // Operand and operator stacks of the parser. They are kept between
+    // calls to interpret() so their storage is reused.
+    std::vector<Symbol*> operands;
+    std::vector<Symbol*> operators;
+
+    // Symbols waiting to be built, each marked once its operands are
+    // on the stack ahead of it, and the nodes built so far.  They are
+    // kept between calls to interpret() so their storage is reused.
+    std::vector<std::pair<Symbol*, bool>> pending;
+    std::vector<Component_Node_Factory::Node> built;
+
+    // Where errors are reported.
+    std::ostream& errors;
 };
 
 #endif // INTERPRETER_H
@@ -0,0 +1,87 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#ifndef JOB_EXECUTOR_H
+#define JOB_EXECUTOR_H
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Interpreter.h"
+#include "Thread_Pool.h"
+
+/**
+ * @class Job_Executor
+ * @brief Evaluates batches of independent jobs, each an expression and
+ *        values for its variables, on a Thread_Pool.
+ *
+ *        Each distinct expression is parsed and compiled once on the
+ *        calling thread.  The jobs are then split into chunks that the
+ *        workers evaluate in parallel; the workers only read the
+ *        compiled programs and keep the variable values of a job in a
+ *        buffer of their own.  Results come back in the order of the
+ *        jobs.
+ */
+class Job_Executor {
+public:
+    /**
+     * @struct Job
+     * @brief An expression and the values of its variables.  Variables
+     *        without a value are 0.
+     */
+    struct Job {
+        std::string expression;
+        std::vector<std::pair<std::string, int>> bindings;
+    };
+
+    // What happened to a job.
+    enum Status { OK, DIVISION_BY_ZERO, MODULUS_BY_ZERO, INVALID_EXPRESSION };
+
+    /**
+     * @struct Result
+     * @brief The value of a job, which is only set if the status is OK.
+     */
+    struct Result {
+        Status status;
+        int value;
+    };
+
+    // Evaluate on @a threads workers, or one per core if it's 0.
+    explicit Job_Executor(std::size_t threads = 0);
+
+    // Evaluate @a jobs and return their results in the same order.
+    std::vector<Result> run(const std::vector<Job>& jobs);
+
+    // Print the jobs and throughput of each worker over all runs.
+    void print_statistics(std::ostream& out) const;
+
+private:
+    /**
+     * @struct Program
+     * @brief A parsed expression and the context its variables have
+     *        slots in.  Trees keep a reference to the context, so a
+     *        program never moves.
+     */
+    struct Program {
+        Interpreter_Context context;
+        Expression_Tree tree;
+    };
+
+    Thread_Pool pool;
+    // Jobs evaluated by each worker.  Only that worker writes to it.
+    std::vector<std::size_t> worker_jobs;
+    // Wall-clock time spent in run().
+    std::chrono::nanoseconds elapsed;
+};
+
+#endif // JOB_EXECUTOR_H
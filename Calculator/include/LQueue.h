@@ -17,15 +17,15 @@ template <typename T> class LQueue_Const_Iterator;
 /**
  * @class LQueue
  * @brief Defines a generic "first-in/first-out" (FIFO) Abstract Data
- *        Type (ADT) using a circular linked list.
+ *        Type (ADT) using a ring of fixed-size chunks.
  *
- *        This queue is a circular linked list where the @a tail_
- *        pointer points to a dummy node which makes implementation
- *        much easier (particularly iterator traversal).  When
- *        enqueuing an item, the dummy node contains the new item and
- *        points to a new dummy node.  The head of the list is thsu
- *        always @a tail_->next_.  Dequeuing an object gets rid of the
- *        head node and makes the dummy node point to the new head.
+ *        Each @a LQueue_Node holds a chunk of items.  Items are added
+ *        at @a last in the @a tail node and removed from @a first in
+ *        the @a head node, and the nodes are linked in a ring so a
+ *        drained head node is reused as the next tail node.  Nodes
+ *        that aren't needed go back to a free list private to the
+ *        thread, so a queue allocates about once per chunk while it
+ *        grows and not at all in a steady state.
  */
 template <typename T> class LQueue {
     friend class LQueue_Iterator<T>;
@@ -51,15 +51,22 @@ public:
     class Overflow {
     };
 
-    /// Constructor.
+    /// Constructor.  @a size_hint items' worth of nodes are put on this
+    /// thread's free list.
     LQueue(size_t size_hint = 0);
 
     /// Copy constructor.
     LQueue(const LQueue<T>& rhs);
 
+    /// Move constructor, which leaves @a rhs empty.
+    LQueue(LQueue<T>&& rhs) noexcept;
+
     /// Assignment operator.
     LQueue<T>& operator=(const LQueue<T>& rhs);
 
+    /// Move assignment operator.
+    LQueue<T>& operator=(LQueue<T>&& rhs) noexcept;
+
     /// Perform actions needed when queue goes out of scope.
     ~LQueue();
 
@@ -68,6 +75,12 @@ public:
     /// exhausted.
     void enqueue(const T& new_item);
 
+    /// Move a @a new_item to the tail of the queue.
+    void enqueue(T&& new_item);
+
+    /// Construct an item from @a args at the tail of the queue.
+    template <typename... Args> void emplace(Args&&... args);
+
     /// Remove and return the front item on the queue.  Throws the @a
     /// Underflow exception if the queue is empty.
     T dequeue();
@@ -114,19 +127,29 @@ protected:
     /// Remove the front item on the queue.  Does not throw exceptions.
     void dequeue_i();
 
-    // Copy a linked list of nodes.  This can throw a @a std::bad_alloc
-    // exception.
+    // Copy the items of another queue.  This can throw a @a
+    // std::bad_alloc exception.
     void copy_list(const LQueue<T>& rhs);
 
-    // Delete a linked list of nodes.
+    // Destroy all items and give the nodes back to the free list.
     void delete_list();
 
+    // Exchange the contents of this queue with @a rhs.
+    void swap(LQueue<T>& rhs) noexcept;
+
 private:
-    /// We only need to keep a single pointer for the circular linked
-    /// list.  This points to the tail of the queue.  Since the list is
-    /// circular, the head of the queue is always @a tail_->next_.
+    /// Node holding the front item, or nullptr until the first enqueue.
+    LQueue_Node<T>* head;
+
+    /// Node holding the back item.
     LQueue_Node<T>* tail;
 
+    /// Index of the front item in @a head.
+    size_t first;
+
+    /// Index one past the back item in @a tail.
+    size_t last;
+
     /// Number of items that are currently in the queue.
     size_t count;
 };
@@ -144,8 +167,8 @@ public:
     /// Construct an LQueue_Iterator at position pos.
     LQueue_Iterator(LQueue<T>& queue, size_t pos = 0);
 
-    /// Construct an LQueue_Iterator at node pos.
-    LQueue_Iterator(LQueue<T>& queue, LQueue_Node<T>* pos = 0);
+    /// Construct an LQueue_Iterator at item @a index of node @a node.
+    LQueue_Iterator(LQueue<T>& queue, LQueue_Node<T>* node, size_t index);
 
     /// Dereference operator returns a reference to the item contained
     /// at the current position
@@ -177,8 +200,9 @@ private:
     /// the queue we are dealing with
     LQueue<T>& queue;
 
-    // the position in the linked list
-    mutable LQueue_Node<T>* pos;
+    // the node and the item in it
+    mutable LQueue_Node<T>* node;
+    mutable size_t index;
 };
 
 /**
@@ -194,8 +218,8 @@ public:
     /// Construct an LQueue_Iterator at position pos.
     LQueue_Const_Iterator(const LQueue<T>& queue, size_t pos = 0);
 
-    /// Construct an LQueue_Iterator at node pos.
-    LQueue_Const_Iterator(const LQueue<T>& queue, LQueue_Node<T>* pos);
+    /// Construct an LQueue_Iterator at item @a index of node @a node.
+    LQueue_Const_Iterator(const LQueue<T>& queue, LQueue_Node<T>* node, size_t index);
 
     /// Dereference operator returns a const reference to the item
     /// contained at the current position.
@@ -224,8 +248,9 @@ private:
     /// the queue we are dealing with
     const LQueue<T>& queue;
 
-    // the position in the linked list
-    mutable LQueue_Node<T>* pos;
+    // the node and the item in it
+    mutable LQueue_Node<T>* node;
+    mutable size_t index;
 };
 
 #include "../src/LQueue.cpp"
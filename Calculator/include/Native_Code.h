@@ -0,0 +1,67 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#ifndef NATIVE_CODE_H
+#define NATIVE_CODE_H
+
+#include <cstddef>
+
+// Forward declarations.
+class Bytecode;
+class Interpreter_Context;
+
+/**
+ * @class Native_Code
+ * @brief A Bytecode program translated into x86-64 machine code.
+ *
+ *        Each instruction becomes a few machine instructions that work
+ *        on the hardware stack, so evaluating the expression is one
+ *        call with no dispatch at all.  The code lives in its own mmap'd
+ *        page, which is made executable (and no longer writable) once
+ *        the code has been written.
+ *
+ *        Only x86-64 Linux is supported, and very large or very deep
+ *        programs aren't translated.  valid() is false in those cases
+ *        and the caller keeps using the Bytecode.
+ */
+class Native_Code {
+public:
+    // Translate @a bytecode.
+    explicit Native_Code(const Bytecode& bytecode);
+
+    // Release the code.
+    ~Native_Code();
+
+    Native_Code(const Native_Code&) = delete;
+    Native_Code& operator=(const Native_Code&) = delete;
+
+    // Return whether the program could be translated.
+    bool valid() const;
+
+    // Run the code and store its value in @a result. Returns false
+    // without a result on division or modulus by zero, like
+    // Bytecode::evaluate().
+    bool evaluate(int& result) const;
+
+    // Return the number of bytes of machine code.
+    std::size_t size() const;
+
+private:
+    // Signature of the generated code.
+    typedef bool (*Function)(const int* variables, int* temporaries, int* result);
+
+    Function function;
+    // The mapping that holds the code.
+    void* memory;
+    std::size_t length;
+    // Context the variables are read from.
+    const Interpreter_Context* context;
+    std::size_t temps;
+};
+
+#endif // NATIVE_CODE_H
@@ -0,0 +1,111 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#ifndef OPTIMIZATION_VISITOR_H
+#define OPTIMIZATION_VISITOR_H
+
+#include <vector>
+
+#include "Component_Node_Factory.h"
+#include "Expression_Tree.h"
+#include "Visitor.h"
+
+/**
+ * @class Optimization_Visitor
+ * @brief This plays the role of a visitor that rebuilds an expression
+ *        tree in a simpler form that evaluates to the same result.
+ *
+ *        Constant subtrees are folded (3*4+x becomes 12+x), the
+ *        identities x*1, 1*x, x+0, 0+x, x-0, x/1, x^1 and --x are
+ *        removed, and small constant powers become multiplications.
+ *        Division and modulus by a constant 0 are left alone so the
+ *        error is still reported when the tree is evaluated, and so
+ *        are constants whose result doesn't fit in an int.
+ */
+class Optimization_Visitor : public Visitor {
+public:
+    // Constructor. When @a share is true the rebuilt nodes are
+    // hash-consed like the Interpreter does with -s.
+    explicit Optimization_Visitor(bool share = false);
+
+    // Return an optimized copy of @a tree. Subtrees shared by several
+    // parents are only optimized once.
+    Expression_Tree optimize(const Expression_Tree& tree);
+
+    // Visit a Leaf_Node.
+    void visit(const Leaf_Node& node) override;
+
+    // Visit a Variable_Node.
+    void visit(const Variable_Node& node) override;
+
+    // Visit a Composite_Negate_Node.
+    void visit(const Composite_Negate_Node& node) override;
+
+    // Visit a Composite_Add_Node.
+    void visit(const Composite_Add_Node& node) override;
+
+    // Visit a Composite_Subtract_Node.
+    void visit(const Composite_Subtract_Node& node) override;
+
+    // Visit a Composite_Divide_Node.
+    void visit(const Composite_Divide_Node& node) override;
+
+    // Visit a Composite_Multiply_Node.
+    void visit(const Composite_Multiply_Node& node) override;
+
+    // Visit a Composite_Modulus_Node.
+    void visit(const Composite_Modulus_Node& node) override;
+
+    // Visit a Composite_Power_Node.
+    void visit(const Composite_Power_Node& node) override;
+
+    // Visit a Composite_Factorial_Node.
+    void visit(const Composite_Factorial_Node& node) override;
+
+private:
+    typedef Component_Node_Factory::Node Node;
+
+    /**
+     * @struct Term
+     * @brief An optimized subtree and what the optimizer needs to know
+     *        about its root.
+     */
+    struct Term {
+        Node node;
+        // Whether the subtree is a number.
+        bool constant;
+        // Whether the subtree is a number or a variable.
+        bool leaf;
+        // Value of a constant subtree.
+        int value;
+        // Whether the subtree is a negation.
+        bool negation;
+        // Operand of a negation, so --x can be replaced by x.
+        Node negated;
+    };
+
+    // Return a term for a number.
+    Term number(int value);
+
+    // Return a term for anything else.
+    Term term(const Node& node, bool leaf = false);
+
+    // Pop the operand of the node being visited.
+    Term pop();
+
+    // Return whether @a t is the constant @a value.
+    static bool is(const Term& t, int value);
+
+    // Makes the rebuilt nodes.
+    Component_Node_Factory factory;
+
+    // Optimized operands of the node being visited.
+    std::vector<Term> stack;
+};
+
+#endif // OPTIMIZATION_VISITOR_H
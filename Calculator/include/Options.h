@@ -32,6 +32,53 @@ public:
     // Run the program in verbose mode.
     bool verbose() const;
 
+    // Number of parsed expressions to keep in the expression cache.
+    std::size_t cache_capacity() const;
+
+    // Build repeated subexpressions as one shared node.
+    bool share_subtrees() const;
+
+    // Fold constants and simplify expressions before evaluating them.
+    bool optimize() const;
+
+    // Translate expressions to machine code before evaluating them.
+    bool jit() const;
+
+    // Print and evaluate expressions from their flat array form.
+    bool flat() const;
+
+    // Print and evaluate trees by following parent links, without a
+    // stack, where the tree has them.
+    bool threaded() const;
+
+    // Expression to evaluate once per row of a table read from standard
+    // input, or empty to run interactively.
+    std::string batch() const;
+
+    // Read jobs from standard input and evaluate them on several threads.
+    bool parallel() const;
+
+    // Split the evaluation of large expressions across several threads.
+    bool fork_join() const;
+
+    // Number of threads for parallel jobs, 0 for one per core.
+    std::size_t job_threads() const;
+
+    // Number of threads for fork-join evaluation, 0 for one per core.
+    std::size_t fork_join_threads() const;
+
+    // Address to serve commands on, a Unix socket path or a loopback
+    // [host:]port, or empty to read them from standard input.
+    std::string serve() const;
+
+    // Number of event loops that serve clients, each on a thread of
+    // its own, 0 for one per core.
+    std::size_t reactors() const;
+
+    // Do clients send batches of commands in length-prefixed frames
+    // instead of lines?
+    bool framed() const;
+
     // Parse command-line arguments and set the appropriate values as
     // follows:
     // 't' - Traversal strategy, i.e., 'P' for pre-order, 'O' for
@@ -51,6 +98,32 @@ private:
     std::string pathStr;
     // Are we running in verbose mode or not?
     bool isVerbose;
+    // Capacity of the expression cache, 0 turns it off.
+    std::size_t cacheCapacity;
+    // Are identical subexpressions shared or not?
+    bool shareSubtrees;
+    // Are expressions optimized or not?
+    bool isOptimized;
+    // Are expressions translated to machine code or not?
+    bool useJit;
+    // Are expressions printed and evaluated from flat arrays or not?
+    bool useFlat;
+    // Are trees walked through parent links or not?
+    bool useThreaded;
+    // Expression to evaluate in batch mode.
+    std::string batchExpression;
+    // Are jobs evaluated in parallel or not, and on how many threads?
+    bool isParallel;
+    std::size_t jobThreads;
+    // Are large expressions evaluated on several threads or not, and on
+    // how many?
+    bool forkJoin;
+    std::size_t forkJoinThreads;
+    // Address of the server, if it's running as one.
+    std::string serveAddress;
+    std::size_t reactorCount;
+    // Do clients send their commands in frames?
+    bool useFrames;
 
     // Pointer to the singleton Options instance.
     static Options* inst;
@@ -0,0 +1,53 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#ifndef OUTPUT_BUFFER_H
+#define OUTPUT_BUFFER_H
+
+#include <cstddef>
+#include <streambuf>
+#include <string>
+
+/**
+ * @class Output_Buffer
+ * @brief A stream buffer that keeps everything written to it until it
+ *        is consumed, so the output of many commands can be sent with
+ *        one write.
+ *
+ *        Flushing the stream doesn't send anything.  The storage grows
+ *        as needed and is reused once the output has been consumed.
+ */
+class Output_Buffer : public std::streambuf {
+public:
+    // Constructor.
+    Output_Buffer();
+
+    // Return the output that hasn't been consumed yet.
+    const char* data() const;
+
+    // Return the number of bytes of output that haven't been consumed.
+    std::size_t size() const;
+
+    // Drop the first @a count bytes of output.
+    void consume(std::size_t count);
+
+    // Overwrite @a count bytes of output at @a offset with @a bytes,
+    // e.g., a length that is only known once what follows it has been
+    // written.
+    void replace(std::size_t offset, const char* bytes, std::size_t count);
+
+protected:
+    // Make room for more output and append @a ch.
+    int_type overflow(int_type ch) override;
+
+private:
+    // Storage for the output, of which [pbase(), pptr()) is in use.
+    std::string storage;
+};
+
+#endif // OUTPUT_BUFFER_H
@@ -0,0 +1,52 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#ifndef PARALLEL_EVALUATOR_H
+#define PARALLEL_EVALUATOR_H
+
+#include <cstddef>
+
+// Forward declarations.
+class Component_Node;
+class Thread_Pool;
+
+/**
+ * @class Parallel_Evaluator
+ * @brief Evaluates one large expression tree with fork-join parallelism.
+ *
+ *        When both children of a binary node are at least threshold
+ *        nodes, the left one is handed to the Thread_Pool and the right
+ *        one is evaluated on the current thread, which then helps with
+ *        other tasks until the left one is done.  Anything smaller is
+ *        evaluated on one thread.  The node sizes are the ones counted
+ *        when the tree was built, so nothing is recounted.  Every
+ *        operator works exactly like it does in Bytecode, so the result
+ *        is the same as the sequential one.
+ *
+ *        A node with several parents is evaluated once per parent, so
+ *        this is meant for trees rather than shared DAGs.
+ */
+class Parallel_Evaluator {
+public:
+    // Subtrees smaller than this are not split by default.
+    static constexpr std::size_t default_threshold = 1 << 14;
+
+    // Split the work across @a pool.  @a threshold must be at least 2.
+    explicit Parallel_Evaluator(Thread_Pool& pool, std::size_t threshold = default_threshold);
+
+    // Evaluate the tree rooted at @a root, which must not be null, and
+    // store its value in @a result.  Returns false without a result on
+    // division or modulus by zero, like Bytecode::evaluate().
+    bool evaluate(const Component_Node* root, int& result) const;
+
+private:
+    Thread_Pool& pool;
+    std::size_t threshold;
+};
+
+#endif // PARALLEL_EVALUATOR_H
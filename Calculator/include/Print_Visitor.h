@@ -3,18 +3,24 @@
 #define PRINT_VISITOR_H
 
 #include "Visitor.h"
+#include <iostream>
 
 /**
  * @class Print_Visitor
  * @brief This class serves as a visitor for printing the contents of
- *        nodes to std::cout.
+ *        nodes to an output stream, std::cout by default.
  */
 
 class Print_Visitor : public Visitor {
 public:
+    explicit Print_Visitor(std::ostream& out = std::cout);
+
     // Visits a Leaf_Node and prints it contents to std::cout.
     void visit(const Leaf_Node& node) override;
 
+    // Visits a Variable_Node and prints its current value to std::cout.
+    void visit(const Variable_Node& node) override;
+
     // Visit a Composite_Negate_Node and prints its contents to std::cout.
     void visit(const Composite_Negate_Node& node) override;
 
@@ -39,6 +45,10 @@ public:
 
     // visit function - prints Composite_Modulus_Node contents to std::cout
     void visit(const Composite_Factorial_Node& node) override;
+
+private:
+    // Where the nodes are printed.
+    std::ostream& out;
 };
 
 #endif // PRINT_VISITOR_H
@@ -2,6 +2,10 @@
 #ifndef REACTOR_H
 #define REACTOR_H
 
+#include <chrono>
+#include <cstddef>
+#include <sys/epoll.h>
+#include <unordered_map>
 #include <vector>
 
 // Forward declarations.
@@ -13,12 +17,15 @@ class Event_Handler;
  *        event handler callback methods in response to input events.
  *
  *        This class plays the role of the "reactor" in the
- *        Reactor pattern.  It is access as a singleton and uses the
- *        Iterator pattern to dispatch the various event handlers.
+ *        Reactor pattern.  It is access as a singleton per thread,
+ *        waits on the handles of all its event handlers with one
+ *        edge-triggered epoll set, and keeps their timers in a timer
+ *        wheel, so one thread serves any number of input sources and
+ *        several threads can run event loops that share nothing.
  */
 class Reactor {
 public:
-    // Singleton access point.
+    // Singleton access point, for the calling thread.
     static Reactor* instance();
 
     // Dtor.
@@ -30,21 +37,103 @@ public:
     // End the reactor's event loop.
     void end_event_loop();
 
-    // Register event_handler for input events.
+    // Register event_handler for input events on its handle, and for
+    // output events once writes that would have blocked can go on.
+    // The handle is made non-blocking until the handler is removed.
     void register_input_handler(Event_Handler* event_handler);
 
-    // Remove event_handler for input events.
+    // Remove event_handler for input events and cancel its timers.  The
+    // handler is deleted once the callback that is running returns.
     void remove_input_handler(Event_Handler* event_handler);
 
+    // Call back the handle_timeout() method of the registered
+    // event_handler after delay, and then every interval if it isn't
+    // zero.  Returns an id for cancel_timer().
+    long schedule_timer(Event_Handler* event_handler, std::chrono::milliseconds delay,
+        std::chrono::milliseconds interval = std::chrono::milliseconds::zero());
+
+    // Cancel a timer.  Returns false if it has already expired.
+    bool cancel_timer(long timer_id);
+
 private:
     // Constructor is private to ensure use as a singleton.
     Reactor();
 
-    // Pointer to the singleton instance of the Reactor.
-    static Reactor* inst;
+    /**
+     * @struct Registration
+     * @brief What the Reactor keeps for each registered handler.
+     */
+    struct Registration {
+        // The handler's handle, or -1 if it only has timers.
+        int handle;
+        // The handle's file status flags before it was registered.
+        int flags;
+        // Is the handle in the epoll set or always ready?
+        bool polled;
+        // Tells this registration apart from earlier ones of a handler
+        // at the same address.
+        unsigned long serial;
+    };
+
+    /**
+     * @struct Timer
+     * @brief A timer in one slot of the timer wheel.
+     */
+    struct Timer {
+        long id;
+        // The handler to call back, or nullptr once cancelled.
+        Event_Handler* handler;
+        unsigned long serial;
+        // Turns of the wheel left before it expires.
+        std::size_t rounds;
+        // Ticks between expiries, 0 for a one-shot timer.
+        std::size_t interval;
+        // Next timer in the same slot.
+        Timer* next;
+    };
+
+    // Put timer in the slot that comes around in ticks.
+    void place(Timer* timer, std::size_t ticks);
+
+    // Expire the timers of every tick up to now.
+    void expire_timers();
+
+    // Return the number of ticks since the reactor started.
+    std::size_t current_tick() const;
+
+    // Return how long epoll_wait() may block, in milliseconds.
+    int wait_time() const;
+
+    // Delete the handlers that were removed.
+    void delete_closed_handlers();
+
+    // Pointer to the singleton instance of the Reactor of this thread.
+    static thread_local Reactor* inst;
+
+    // The registered handlers, used to dispatch callbacks.
+    std::unordered_map<Event_Handler*, Registration> dispatch_table;
+
+    // Handlers whose handles epoll can't wait on, e.g. regular files,
+    // which are always ready.
+    std::vector<Event_Handler*> ready_handlers;
+
+    // Handlers removed while their callbacks may still be running.
+    std::vector<Event_Handler*> closed_handlers;
+
+    // The epoll set and the events returned by the last wait.
+    int epoll_handle;
+    std::vector<epoll_event> events;
+    int event_count;
+    int next_event;
 
-    // Vector of pointers to Event_Handler objects used to dispatch callbacks.
-    std::vector<Event_Handler*> dispatch_table;
+    // The timer wheel, the pending timers by id, and the tick the wheel
+    // has been turned to.
+    std::vector<Timer*> wheel;
+    std::unordered_map<long, Timer*> timers;
+    std::chrono::steady_clock::time_point start;
+    std::size_t now;
+    long next_timer_id;
+    unsigned long next_serial;
 
     // Keeps track of whether we're running the event loop or not.
     bool running_event_loop;
@@ -0,0 +1,74 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#ifndef REFCOUNTED_H
+#define REFCOUNTED_H
+
+#include <atomic>
+#include <type_traits>
+
+/**
+ * @class Refcounted
+ * @brief Base class for objects that keep their own reference count.
+ *
+ *        Refcounter counts references to these objects in the objects
+ *        themselves instead of allocating a Shim for every pointer it
+ *        wraps.  With ATOMIC the count is a std::atomic, so references
+ *        to the same object can be taken and dropped on several threads.
+ */
+template <bool ATOMIC = false> class Refcounted {
+public:
+    // Add a reference.
+    void add_reference() const
+    {
+        if constexpr (ATOMIC)
+            references.fetch_add(1, std::memory_order_relaxed);
+        else
+            ++references;
+    }
+
+    // Drop a reference and return whether it was the last one.
+    bool release_reference() const
+    {
+        if constexpr (ATOMIC)
+            return references.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        else
+            return --references == 0;
+    }
+
+    // Return the number of references.
+    int reference_count() const
+    {
+        return references;
+    }
+
+protected:
+    // An object starts without references; Refcounter adds the first.
+    Refcounted()
+        : references(0)
+    {
+    }
+
+    // A copy is a new object with references of its own.
+    Refcounted(const Refcounted&)
+        : references(0)
+    {
+    }
+
+    Refcounted& operator=(const Refcounted&)
+    {
+        return *this;
+    }
+
+    ~Refcounted() = default;
+
+private:
+    mutable std::conditional_t<ATOMIC, std::atomic<int>, int> references;
+};
+
+#endif // REFCOUNTED_H
@@ -2,27 +2,36 @@
 #ifndef REFCOUNTER_H
 #define REFCOUNTER_H
 
+#include "Refcounted.h"
+
 /**
  * @class Refcounter
  * @brief This template class provides transparent reference counting
  *        of its template parameter T.
  *
  *        This class can be used to automate the implementation of the
- *        Bridge pattern in C++.
+ *        Bridge pattern in C++.  If T derives from Refcounted the count
+ *        is kept in the object itself and wrapping a pointer never
+ *        allocates; otherwise the count lives in a separate Shim.
  */
 template <typename T> class Refcounter {
 public:
     // default Ctor
     Refcounter();
 
-    // Ctor with refcounting functionality
+    // Ctor with refcounting functionality.  An object that counts its
+    // own references always gets exactly one more, so @a increase_count
+    // only matters for Shims.
     Refcounter(T* ptr, bool increase_count = false);
 
     // copy Ctor
     Refcounter(const Refcounter& rhs);
 
+    // move Ctor, leaves @a rhs null
+    Refcounter(Refcounter&& rhs) noexcept;
+
     // Dtor will delete pointer if refcount becomes 0
-    virtual ~Refcounter();
+    ~Refcounter();
 
     // assignment operator for times when you don't want
     // the reference increased for incoming ptr
@@ -31,6 +40,9 @@ public:
     // assignment operator
     void operator=(const Refcounter& rhs);
 
+    // move assignment operator, leaves @a rhs null
+    void operator=(Refcounter&& rhs) noexcept;
+
     // dereference operator
     T& operator*();
 
@@ -50,12 +62,21 @@ public:
     const T* get_ptr() const;
 
 private:
+    // Return whether T counts its own references.  Only called from
+    // member functions, so T may still be incomplete where the class
+    // is used.
+    static constexpr bool intrusive();
+
     // implementation of the increment operation
     void increment();
 
     // implementation of the decrement operation
     void decrement();
 
+    // Delete @a doomed (an object or a Shim) without recursing into
+    // the objects it releases.
+    template <typename U> static void dispose(U* doomed);
+
     // A shim class that keeps track of the reference count and a
     // pointer to the type T that's reference counted.
     struct Shim {
@@ -72,8 +93,14 @@ private:
         int refcount;
     };
 
-    // Pointer to the Shim.
-    Shim* ptr;
+    // Return the object, if it counts its own references.
+    T* object() const;
+
+    // Return the Shim otherwise.
+    Shim* shim() const;
+
+    // Pointer to the object or to its Shim.
+    void* ptr;
 };
 
 #include "../src/Refcounter.cpp"
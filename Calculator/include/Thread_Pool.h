@@ -0,0 +1,119 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class Thread_Pool
+ * @brief A fixed set of worker threads that share tasks by work stealing.
+ *
+ *        Every worker has its own deque.  A worker takes its newest task
+ *        from the back of its deque, and when the deque is empty it
+ *        steals the oldest task from the front of another worker's, so
+ *        workers that finish early take over the rest of the work.
+ */
+class Thread_Pool {
+public:
+    typedef std::function<void()> Task;
+
+    /**
+     * @struct Statistics
+     * @brief What one worker has done so far.
+     */
+    struct Statistics {
+        // Tasks the worker ran.
+        std::size_t executed;
+        // Tasks it took from other workers.
+        std::size_t stolen;
+        // Time spent running tasks.
+        std::chrono::nanoseconds busy;
+    };
+
+    // Start @a threads workers, or one per core if it's 0.
+    explicit Thread_Pool(std::size_t threads = 0);
+
+    // Wait for the tasks that are queued and stop the workers.
+    ~Thread_Pool();
+
+    Thread_Pool(const Thread_Pool&) = delete;
+    Thread_Pool& operator=(const Thread_Pool&) = delete;
+
+    // Queue a task.  From a worker it goes on that worker's deque,
+    // otherwise the deques take turns.
+    void submit(Task task);
+
+    // Wait until every submitted task has run.
+    void wait();
+
+    // Run one queued task on the calling thread, if there is one.  A
+    // task that waits for a task it submitted calls this so the worker
+    // helps instead of blocking.
+    bool run_one();
+
+    // Return the number of workers.
+    std::size_t size() const;
+
+    // Return the index of the worker running the caller, or -1 if the
+    // caller isn't one of this pool's workers.
+    int worker() const;
+
+    // Return the statistics of worker @a index.  Only exact while no
+    // tasks are running.
+    Statistics statistics(std::size_t index) const;
+
+private:
+    /**
+     * @struct Worker
+     * @brief A thread and its deque of tasks.
+     */
+    struct Worker {
+        std::mutex lock;
+        std::deque<Task> tasks;
+        Statistics statistics;
+        std::thread thread;
+    };
+
+    // Body of worker @a index.
+    void run(std::size_t index);
+
+    // Take a task for worker @a index, stealing if its deque is empty.
+    // An @a index of -1 only steals.
+    bool take(int index, Task& task);
+
+    // Run @a task for worker @a index (-1 if it's not a worker).
+    void execute(int index, Task& task);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    // Guards sleeping and waking, and the counters below when they are
+    // waited on.
+    std::mutex state_lock;
+    std::condition_variable work_ready;
+    std::condition_variable all_done;
+    // Tasks that are queued but not taken yet.
+    std::atomic<std::size_t> queued;
+    // Tasks that are queued or running.
+    std::atomic<std::size_t> unfinished;
+    // Deque the next task from outside the pool goes on.
+    std::atomic<std::size_t> next;
+    bool stopping;
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,59 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <string_view>
+
+/**
+ * @class Tokenizer
+ * @brief Splits an infix expression into numbers, variables, operators
+ *        and parentheses.
+ *
+ *        Tokens are std::string_view spans into the original input, so
+ *        tokenizing never copies or allocates.  The input has to
+ *        outlive the tokens.
+ */
+class Tokenizer {
+public:
+    // The kinds of tokens an expression is made of.
+    enum Kind { NUMBER, VARIABLE, OPERATOR, LEFT_PAREN, RIGHT_PAREN, END };
+
+    /**
+     * @struct Token
+     * @brief A token and the span of input it was read from.
+     */
+    struct Token {
+        // What kind of token this is.
+        Kind kind;
+        // The characters of the token.
+        std::string_view text;
+    };
+
+    // Constructor.
+    explicit Tokenizer(std::string_view input);
+
+    // Return the next token, skipping whitespace.  Returns an END token
+    // once the input is used up and throws std::domain_error on a
+    // character that can't start a token.
+    Token next();
+
+    // Convert the text of a NUMBER token to an int.  Throws
+    // std::domain_error if the number doesn't fit in an int.
+    static int to_int(std::string_view digits);
+
+private:
+    // The expression being tokenized.
+    std::string_view input;
+
+    // Position of the next unread character.
+    std::string_view::size_type pos;
+};
+
+#endif // TOKENIZER_H
@@ -0,0 +1,158 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#ifndef TREE_TRAVERSAL_H
+#define TREE_TRAVERSAL_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string>
+
+// Forward declaration.
+class Component_Node;
+
+/**
+ * @class Tree_Traversal
+ * @brief Walks the nodes of a tree in pre-, in-, post- or level-order
+ *        without allocating.
+ *
+ *        The order is an enum instead of a string looked up in a map,
+ *        and the traversal lives on the caller's stack.  The pending
+ *        nodes are kept in a fixed array whose size comes from the
+ *        height counted when the tree was built.  Only trees taller
+ *        than the inline array, or level-order walks wider than it,
+ *        use the heap.  Nodes come out in the same sequence as the
+ *        Expression_Tree iterators produce them.
+ *
+ *        A threaded traversal follows the parent links of the nodes
+ *        instead, so pre-, in- and post-order walks need no pending
+ *        nodes at all however deep the tree is.  It's used only when
+ *        the root reports threaded(), i.e. no node below it is shared.
+ *        Level-order always queues, but the queue only grows to the
+ *        widest level, which stays small for deep, narrow trees.
+ */
+class Tree_Traversal {
+public:
+    // The traversal orders.
+    enum Order { IN_ORDER, PRE_ORDER, POST_ORDER, LEVEL_ORDER };
+
+    // Return the order called @a name ("in-order", "pre-order",
+    // "post-order" or "level-order").  Throws
+    // Expression_Tree::Invalid_Iterator for any other name.
+    static Order order(const std::string& name);
+
+    // Walk the tree rooted at @a root, which may be null, in @a order,
+    // through parent links if @a threaded and the tree allows it.
+    Tree_Traversal(const Component_Node* root, Order order, bool threaded = false);
+
+    Tree_Traversal(const Tree_Traversal&) = delete;
+    Tree_Traversal& operator=(const Tree_Traversal&) = delete;
+
+    // Return the next node, or nullptr after the last one.
+    const Component_Node* next();
+
+    // Return true if the walk follows parent links.
+    bool threaded() const;
+
+    /**
+     * @class iterator
+     * @brief Input iterator over the rest of a traversal, so it can be
+     *        used in a range-based for loop.
+     */
+    class iterator {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef const Component_Node value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Component_Node* pointer;
+        typedef const Component_Node& reference;
+
+        iterator(Tree_Traversal* traversal, const Component_Node* node)
+            : traversal(traversal)
+            , node(node)
+        {
+        }
+
+        reference operator*() const
+        {
+            return *node;
+        }
+
+        iterator& operator++()
+        {
+            node = traversal->next();
+            return *this;
+        }
+
+        bool operator!=(const iterator& rhs) const
+        {
+            return node != rhs.node;
+        }
+
+        bool operator==(const iterator& rhs) const
+        {
+            return node == rhs.node;
+        }
+
+    private:
+        Tree_Traversal* traversal;
+        const Component_Node* node;
+    };
+
+    // Return an iterator at the next node.
+    iterator begin();
+
+    // Return the iterator past the last node.
+    iterator end();
+
+private:
+    /**
+     * @struct Entry
+     * @brief A pending node, and for post-order whether its children
+     *        are already pending ahead of it.
+     */
+    struct Entry {
+        const Component_Node* node;
+        bool expanded;
+    };
+
+    // Pending nodes that fit without touching the heap.
+    static constexpr std::size_t inline_capacity = 64;
+
+    // Add a node to the back of the pending nodes.
+    void push(const Component_Node* node, bool expanded = false);
+
+    // Push the left spine of @a node (in-order).
+    void push_left(const Component_Node* node);
+
+    // Expand post-order entries until the top one can be visited.
+    void descend();
+
+    // Return the first node of a threaded walk of the subtree at @a node.
+    const Component_Node* first_linked(const Component_Node* node) const;
+
+    // Return the node after @a node in a threaded walk, or nullptr.
+    const Component_Node* next_linked(const Component_Node* node) const;
+
+    Order walk_order;
+    // Root and next node of a threaded walk, which uses no entries.
+    const Component_Node* root;
+    const Component_Node* current;
+    bool use_links;
+    // Pending nodes: a stack in entries[0, count) or, for level-order,
+    // a ring that starts at @a first.
+    Entry* entries;
+    std::size_t capacity;
+    std::size_t first;
+    std::size_t count;
+    Entry inline_entries[inline_capacity];
+    std::unique_ptr<Entry[]> heap_entries;
+};
+
+#endif // TREE_TRAVERSAL_H
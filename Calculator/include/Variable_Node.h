@@ -0,0 +1,53 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#ifndef VARIABLE_NODE_H
+#define VARIABLE_NODE_H
+
+#include "Component_Node.h"
+
+// Forward declarations.
+class Visitor;
+class Interpreter_Context;
+
+/**
+ * @class Variable_Node
+ * @brief Defines a terminal node that refers to a variable in an
+ *        Interpreter_Context.  The value is read every time the node
+ *        is visited, so a tree picks up new "set" values without being
+ *        parsed again.
+ */
+class Variable_Node : public Component_Node {
+public:
+    // Ctor.
+    Variable_Node(const Interpreter_Context& context, int slot);
+
+    // Dtor.
+    ~Variable_Node() override = default;
+
+    // Return the current value of the variable.
+    int item() const override;
+
+    // Return the slot of the variable in its Interpreter_Context.
+    int slot() const;
+
+    // Return the Interpreter_Context that holds the variable.
+    const Interpreter_Context& context() const;
+
+    // Define the accept() operation used for the Visitor pattern.
+    void accept(Visitor& visitor) const override;
+
+private:
+    // Context that holds the value of the variable.
+    const Interpreter_Context& int_context;
+
+    // Slot of the variable in the context.
+    int index;
+};
+
+#endif // VARIABLE_NODE_H
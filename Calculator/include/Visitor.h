@@ -3,6 +3,7 @@
 #define VISITOR_H
 
 class Leaf_Node;
+class Variable_Node;
 class Composite_Negate_Node;
 class Composite_Add_Node;
 class Composite_Subtract_Node;
@@ -25,6 +26,9 @@ public:
     // Visit a Leaf_Node.
     virtual void visit(const Leaf_Node& node) = 0;
 
+    // Visit a Variable_Node.
+    virtual void visit(const Variable_Node& node) = 0;
+
     // Visit a Composite_Negate_Node.
     virtual void visit(const Composite_Negate_Node& node) = 0;
 
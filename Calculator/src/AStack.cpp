@@ -0,0 +1,296 @@
+/* -*- C++ -*- */
+#ifndef ASTACK_CPP
+#define ASTACK_CPP
+
+#include "AStack.h"
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <utility>
+
+// Returns the current size.
+template <typename T, size_t N> size_t AStack<T, N>::size() const
+{
+    return count;
+}
+
+// Constructor.
+template <typename T, size_t N>
+AStack<T, N>::AStack(size_t size_hint)
+    : items(reinterpret_cast<T*>(buffer))
+    , count(0)
+    , capacity(N)
+{
+    static_assert(N > 0, "AStack needs room for at least one item");
+
+    // use the size_hint to allocate the heap array up front
+    if (size_hint > N) {
+        try {
+            items = std::allocator<T>().allocate(size_hint);
+            capacity = size_hint;
+        } catch (const std::bad_alloc&) {
+            throw Overflow();
+        }
+    }
+}
+
+// Copy constructor.
+template <typename T, size_t N>
+AStack<T, N>::AStack(const AStack<T, N>& rhs)
+    : AStack(rhs.count)
+{
+    // the delegated constructor has finished, so the destructor cleans
+    // up if a copy throws
+    for (size_t i = 0; i < rhs.count; ++i)
+        emplace(rhs.items[i]);
+}
+
+// Move constructor.
+template <typename T, size_t N>
+AStack<T, N>::AStack(AStack<T, N>&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+    : AStack()
+{
+    take(rhs);
+}
+
+// Assignment operator.
+template <typename T, size_t N> AStack<T, N>& AStack<T, N>::operator=(const AStack<T, N>& rhs)
+{
+    // test for self assignment first
+    if (this != &rhs) {
+        // copy first so a failure leaves this stack as it was
+        AStack<T, N> temp(rhs);
+        *this = std::move(temp);
+    }
+
+    return *this;
+}
+
+// Move assignment operator.
+template <typename T, size_t N>
+AStack<T, N>& AStack<T, N>::operator=(AStack<T, N>&& rhs) noexcept(
+    std::is_nothrow_move_constructible<T>::value)
+{
+    if (this != &rhs) {
+        erase();
+        if (!is_inline()) {
+            std::allocator<T>().deallocate(items, capacity);
+            items = reinterpret_cast<T*>(buffer);
+            capacity = N;
+        }
+        take(rhs);
+    }
+
+    return *this;
+}
+
+// Perform actions needed when stack goes out of scope.
+template <typename T, size_t N> AStack<T, N>::~AStack()
+{
+    erase();
+    if (!is_inline())
+        std::allocator<T>().deallocate(items, capacity);
+}
+
+// Move all the items of <rhs> to this empty, inline stack.
+template <typename T, size_t N> void AStack<T, N>::take(AStack<T, N>& rhs)
+{
+    if (!rhs.is_inline()) {
+        // a heap array just changes hands
+        items = rhs.items;
+        capacity = rhs.capacity;
+        count = rhs.count;
+        rhs.items = reinterpret_cast<T*>(rhs.buffer);
+        rhs.capacity = N;
+        rhs.count = 0;
+        return;
+    }
+
+    for (; count < rhs.count; ++count)
+        new (items + count) T(std::move(rhs.items[count]));
+    rhs.erase();
+}
+
+// Returns true if the items are in the inline buffer.
+template <typename T, size_t N> bool AStack<T, N>::is_inline() const
+{
+    return items == reinterpret_cast<const T*>(buffer);
+}
+
+// Compare this stack with <rhs> for equality.  Returns true if the
+// size()'s of the two stacks are equal and all the elements from 0
+// .. size() are equal, else false.
+template <typename T, size_t N> bool AStack<T, N>::operator==(const AStack<T, N>& rhs) const
+{
+    return (size() == rhs.size()) && std::equal(begin(), end(), rhs.begin());
+}
+
+// Compare this stack with <rhs> for inequality such that <*this> !=
+// <s> is always the complement of the boolean return value of
+// <*this> == <s>.
+template <typename T, size_t N> bool AStack<T, N>::operator!=(const AStack<T, N>& rhs) const
+{
+    return !(*this == rhs);
+}
+
+// Place a <new_item> on top of the stack.
+template <typename T, size_t N> void AStack<T, N>::push(const T& new_item)
+{
+    emplace(new_item);
+}
+
+// Move a <new_item> on top of the stack.
+template <typename T, size_t N> void AStack<T, N>::push(T&& new_item)
+{
+    emplace(std::move(new_item));
+}
+
+// Construct an item on top of the stack.  Throws the <Overflow>
+// exception if the items no longer fit and memory is exhausted.
+template <typename T, size_t N>
+template <typename... Args>
+void AStack<T, N>::emplace(Args&&... args)
+{
+    if (count == capacity) {
+        try {
+            // the new item is built first, since args may refer to an
+            // item that is about to move
+            grow(2 * capacity, [&](T* slot) { new (slot) T(std::forward<Args>(args)...); });
+        } catch (const std::bad_alloc&) {
+            // we transform a bad_alloc exception into an overflow
+            // exception, because it basically means, that it is no
+            // longer possible to push new elements
+            throw Overflow();
+        }
+    } else {
+        new (items + count) T(std::forward<Args>(args)...);
+    }
+
+    // increment the element count
+    ++count;
+}
+
+// Move the items to a larger heap array.  Nothing changes if an
+// allocation or a constructor throws.
+template <typename T, size_t N>
+template <typename MAKE>
+void AStack<T, N>::grow(size_t larger, MAKE make)
+{
+    std::allocator<T> allocator;
+    T* larger_items = allocator.allocate(larger);
+    size_t moved = 0;
+
+    try {
+        make(larger_items + count);
+        try {
+            for (; moved < count; ++moved)
+                new (larger_items + moved) T(std::move_if_noexcept(items[moved]));
+        } catch (...) {
+            while (moved > 0)
+                larger_items[--moved].~T();
+            larger_items[count].~T();
+            throw;
+        }
+    } catch (...) {
+        allocator.deallocate(larger_items, larger);
+        throw;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+        items[i].~T();
+    if (!is_inline())
+        allocator.deallocate(items, capacity);
+    items = larger_items;
+    capacity = larger;
+}
+
+// Remove and return the top item on the stack.
+// Throws the <Underflow> exception if the stack is empty.
+template <typename T, size_t N> T AStack<T, N>::pop()
+{
+    // check for empty stack first
+    if (is_empty()) {
+        throw Underflow();
+    }
+
+    // move the item out before it is destroyed
+    T item(std::move(items[count - 1]));
+
+    // call actual pop implementation
+    pop_i();
+
+    return item;
+}
+
+template <typename T, size_t N> void AStack<T, N>::pop_i()
+{
+    items[--count].~T();
+}
+
+// Remove all the items, keeping the storage.
+template <typename T, size_t N> void AStack<T, N>::erase()
+{
+    while (count > 0)
+        pop_i();
+}
+
+// Returns the top item without removing it.
+// Throws the <Underflow> exception if the stack is empty.
+template <typename T, size_t N> T& AStack<T, N>::top()
+{
+    // check for empty stack first
+    if (is_empty())
+        throw Underflow();
+
+    return items[count - 1];
+}
+
+template <typename T, size_t N> const T& AStack<T, N>::top() const
+{
+    // check for empty stack first
+    if (is_empty())
+        throw Underflow();
+
+    return items[count - 1];
+}
+
+// Returns true if the stack is empty, otherwise returns false.
+template <typename T, size_t N> bool AStack<T, N>::is_empty() const
+{
+    return count == 0;
+}
+
+// Returns true if the stack is full, otherwise returns false.
+template <typename T, size_t N> bool AStack<T, N>::is_full() const
+{
+    // the heap array can always grow
+    return false;
+}
+
+// Get an iterator to the top of the stack
+template <typename T, size_t N> typename AStack<T, N>::iterator AStack<T, N>::begin()
+{
+    return iterator(items + count);
+}
+
+// Get an iterator pointing past the bottom of the stack
+template <typename T, size_t N> typename AStack<T, N>::iterator AStack<T, N>::end()
+{
+    return iterator(items);
+}
+
+// Get an iterator to the top of the stack
+template <typename T, size_t N>
+typename AStack<T, N>::const_iterator AStack<T, N>::begin() const
+{
+    return const_iterator(items + count);
+}
+
+// Get an iterator pointing past the bottom of the stack
+template <typename T, size_t N>
+typename AStack<T, N>::const_iterator AStack<T, N>::end() const
+{
+    return const_iterator(items);
+}
+
+#endif // ASTACK_CPP
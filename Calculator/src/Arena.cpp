@@ -0,0 +1,81 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#include "Arena.h"
+#include <cstdint>
+#include <new>
+
+// Ctor
+Arena::Arena(std::size_t block_size)
+    : head(nullptr)
+    , cursor(nullptr)
+    , limit(nullptr)
+    , block_size(block_size)
+{
+}
+
+// Dtor
+Arena::~Arena()
+{
+    while (head) {
+        Block* next = head->next;
+        ::operator delete(head);
+        head = next;
+    }
+}
+
+// Return the first usable byte of a block.
+char* Arena::begin(Block* block)
+{
+    return reinterpret_cast<char*>(block) + sizeof(Block);
+}
+
+// Hand out the next aligned chunk of the head block, starting a new
+// block when it doesn't fit.
+void* Arena::allocate(std::size_t bytes, std::size_t alignment)
+{
+    auto address = reinterpret_cast<std::uintptr_t>(cursor);
+    auto aligned = (address + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+
+    if (!head || aligned + bytes > reinterpret_cast<std::uintptr_t>(limit)) {
+        grow(bytes + alignment);
+        address = reinterpret_cast<std::uintptr_t>(cursor);
+        aligned = (address + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+    }
+
+    cursor = reinterpret_cast<char*>(aligned + bytes);
+    return reinterpret_cast<void*>(aligned);
+}
+
+// Start a new block in front of the existing ones.
+void Arena::grow(std::size_t bytes)
+{
+    std::size_t size = bytes > block_size ? bytes : block_size;
+    auto block = static_cast<Block*>(::operator new(sizeof(Block) + size));
+    block->next = head;
+    block->size = size;
+    head = block;
+    cursor = begin(block);
+    limit = cursor + size;
+}
+
+// Free every block but the oldest one, which is reused from the start.
+void Arena::reset()
+{
+    if (!head)
+        return;
+
+    while (head->next) {
+        Block* next = head->next;
+        ::operator delete(head);
+        head = next;
+    }
+
+    cursor = begin(head);
+    limit = cursor + head->size;
+}
@@ -0,0 +1,372 @@
+/* -*- C++ -*- */
+#ifndef BQUEUE_CPP
+#define BQUEUE_CPP
+
+#include "BQueue.h"
+#include <algorithm>
+#include <new>
+#include <utility>
+
+namespace bqueue_detail {
+// Return the smallest power of two that is at least @a size and 2.
+inline size_t ring_size(size_t size)
+{
+    size_t ring = 2;
+    while (ring < size)
+        ring *= 2;
+    return ring;
+}
+}
+
+template <typename T, bool SPSC> T* BQueue<T, SPSC>::Cell::item()
+{
+    return std::launder(reinterpret_cast<T*>(&storage));
+}
+
+// Constructor.
+template <typename T, bool SPSC>
+BQueue<T, SPSC>::BQueue(size_t size)
+    : cells(new Cell[bqueue_detail::ring_size(size)])
+    , mask(bqueue_detail::ring_size(size) - 1)
+    , tail(0)
+    , head(0)
+{
+    // cell i is first written at position i
+    for (size_t i = 0; i <= mask; ++i)
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template <typename T, bool SPSC> BQueue<T, SPSC>::~BQueue()
+{
+    for (size_t position = head.load(); position != tail.load(); ++position)
+        cells[position & mask].item()->~T();
+    delete[] cells;
+}
+
+// A cell is free for position p when its sequence is p and holds the
+// item for position p when its sequence is p + 1.  The cells after the
+// first are claimed with it as long as they are in the same state, so
+// a batch costs one compare-and-swap.
+template <typename T, bool SPSC> size_t BQueue<T, SPSC>::claim_tail(size_t& n)
+{
+    size_t position = tail.load(std::memory_order_relaxed);
+    for (;;) {
+        size_t sequence = cells[position & mask].sequence.load(std::memory_order_acquire);
+        if (sequence < position) {
+            // the cell still holds an item from the last lap
+            n = 0;
+            return position;
+        }
+        if (sequence > position) {
+            // another producer got here first
+            position = tail.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        size_t claimed = 1;
+        while (claimed < n
+            && cells[(position + claimed) & mask].sequence.load(std::memory_order_acquire)
+                == position + claimed)
+            ++claimed;
+        if (tail.compare_exchange_weak(position, position + claimed, std::memory_order_relaxed)) {
+            n = claimed;
+            return position;
+        }
+    }
+}
+
+template <typename T, bool SPSC> size_t BQueue<T, SPSC>::claim_head(size_t& n)
+{
+    size_t position = head.load(std::memory_order_relaxed);
+    for (;;) {
+        size_t sequence = cells[position & mask].sequence.load(std::memory_order_acquire);
+        if (sequence < position + 1) {
+            // nothing has been written here on this lap yet
+            n = 0;
+            return position;
+        }
+        if (sequence > position + 1) {
+            position = head.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        size_t claimed = 1;
+        while (claimed < n
+            && cells[(position + claimed) & mask].sequence.load(std::memory_order_acquire)
+                == position + claimed + 1)
+            ++claimed;
+        if (head.compare_exchange_weak(position, position + claimed, std::memory_order_relaxed)) {
+            n = claimed;
+            return position;
+        }
+    }
+}
+
+template <typename T, bool SPSC>
+template <typename... Args>
+void BQueue<T, SPSC>::put(size_t position, Args&&... args) noexcept
+{
+    Cell& cell = cells[position & mask];
+    new (cell.item()) T(std::forward<Args>(args)...);
+    cell.sequence.store(position + 1, std::memory_order_release);
+}
+
+template <typename T, bool SPSC> T BQueue<T, SPSC>::take(size_t position) noexcept
+{
+    Cell& cell = cells[position & mask];
+    T item(std::move(*cell.item()));
+    cell.item()->~T();
+    // free for the position one lap later
+    cell.sequence.store(position + mask + 1, std::memory_order_release);
+    return item;
+}
+
+template <typename T, bool SPSC> void BQueue<T, SPSC>::take(size_t position, T& item) noexcept
+{
+    Cell& cell = cells[position & mask];
+    item = std::move(*cell.item());
+    cell.item()->~T();
+    cell.sequence.store(position + mask + 1, std::memory_order_release);
+}
+
+template <typename T, bool SPSC> bool BQueue<T, SPSC>::try_enqueue(const T& new_item)
+{
+    size_t n = 1;
+    size_t position = claim_tail(n);
+    if (n == 0)
+        return false;
+    put(position, new_item);
+    return true;
+}
+
+template <typename T, bool SPSC> bool BQueue<T, SPSC>::try_enqueue(T&& new_item)
+{
+    size_t n = 1;
+    size_t position = claim_tail(n);
+    if (n == 0)
+        return false;
+    put(position, std::move(new_item));
+    return true;
+}
+
+template <typename T, bool SPSC> size_t BQueue<T, SPSC>::try_enqueue(T* items, size_t n)
+{
+    if (n == 0)
+        return 0;
+    size_t position = claim_tail(n);
+    for (size_t i = 0; i < n; ++i)
+        put(position + i, std::move(items[i]));
+    return n;
+}
+
+template <typename T, bool SPSC> bool BQueue<T, SPSC>::try_dequeue(T& item)
+{
+    size_t n = 1;
+    size_t position = claim_head(n);
+    if (n == 0)
+        return false;
+    take(position, item);
+    return true;
+}
+
+template <typename T, bool SPSC> size_t BQueue<T, SPSC>::try_dequeue(T* items, size_t n)
+{
+    if (n == 0)
+        return 0;
+    size_t position = claim_head(n);
+    for (size_t i = 0; i < n; ++i)
+        take(position + i, items[i]);
+    return n;
+}
+
+// Place a <new_item> at the tail of the queue.  Throws the <Overflow>
+// exception if the queue is full.
+template <typename T, bool SPSC> void BQueue<T, SPSC>::enqueue(const T& new_item)
+{
+    if (!try_enqueue(new_item))
+        throw Overflow();
+}
+
+// Remove and return the front item on the queue.  Throws the
+// <Underflow> exception if the queue is empty.
+template <typename T, bool SPSC> T BQueue<T, SPSC>::dequeue()
+{
+    size_t n = 1;
+    size_t position = claim_head(n);
+    if (n == 0)
+        throw Underflow();
+    return take(position);
+}
+
+template <typename T, bool SPSC> bool BQueue<T, SPSC>::is_empty() const
+{
+    return size() == 0;
+}
+
+template <typename T, bool SPSC> bool BQueue<T, SPSC>::is_full() const
+{
+    return size() == capacity();
+}
+
+// The head is read first, so the tail read after it can't be behind it.
+template <typename T, bool SPSC> size_t BQueue<T, SPSC>::size() const
+{
+    size_t front = head.load(std::memory_order_acquire);
+    size_t back = tail.load(std::memory_order_acquire);
+    return std::min(back - front, capacity());
+}
+
+template <typename T, bool SPSC> size_t BQueue<T, SPSC>::capacity() const
+{
+    return mask + 1;
+}
+
+// Constructor.
+template <typename T>
+BQueue<T, true>::BQueue(size_t size)
+    : slots(new Slot[bqueue_detail::ring_size(size)])
+    , mask(bqueue_detail::ring_size(size) - 1)
+    , tail(0)
+    , cached_head(0)
+    , head(0)
+    , cached_tail(0)
+{
+}
+
+template <typename T> BQueue<T, true>::~BQueue()
+{
+    for (size_t position = head.load(); position != tail.load(); ++position)
+        item(position)->~T();
+    delete[] slots;
+}
+
+template <typename T> T* BQueue<T, true>::item(size_t position)
+{
+    return std::launder(reinterpret_cast<T*>(&slots[position & mask]));
+}
+
+template <typename T> size_t BQueue<T, true>::room(size_t n)
+{
+    size_t back = tail.load(std::memory_order_relaxed);
+    if (capacity() - (back - cached_head) < n)
+        cached_head = head.load(std::memory_order_acquire);
+    return std::min(n, capacity() - (back - cached_head));
+}
+
+template <typename T> size_t BQueue<T, true>::ready(size_t n)
+{
+    size_t front = head.load(std::memory_order_relaxed);
+    if (cached_tail - front < n)
+        cached_tail = tail.load(std::memory_order_acquire);
+    return std::min(n, cached_tail - front);
+}
+
+// Nothing is published until the item is built, so an exception from
+// T leaves the queue as it was.
+template <typename T> bool BQueue<T, true>::try_enqueue(const T& new_item)
+{
+    if (room(1) == 0)
+        return false;
+    size_t back = tail.load(std::memory_order_relaxed);
+    new (item(back)) T(new_item);
+    tail.store(back + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T> bool BQueue<T, true>::try_enqueue(T&& new_item)
+{
+    if (room(1) == 0)
+        return false;
+    size_t back = tail.load(std::memory_order_relaxed);
+    new (item(back)) T(std::move(new_item));
+    tail.store(back + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T> size_t BQueue<T, true>::try_enqueue(T* items, size_t n)
+{
+    n = room(n);
+    size_t back = tail.load(std::memory_order_relaxed);
+    size_t built = 0;
+    try {
+        for (; built < n; ++built)
+            new (item(back + built)) T(std::move(items[built]));
+    } catch (...) {
+        while (built > 0)
+            item(back + --built)->~T();
+        throw;
+    }
+    tail.store(back + n, std::memory_order_release);
+    return n;
+}
+
+template <typename T> bool BQueue<T, true>::try_dequeue(T& out)
+{
+    if (ready(1) == 0)
+        return false;
+    size_t front = head.load(std::memory_order_relaxed);
+    out = std::move(*item(front));
+    item(front)->~T();
+    head.store(front + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T> size_t BQueue<T, true>::try_dequeue(T* items, size_t n)
+{
+    n = ready(n);
+    size_t front = head.load(std::memory_order_relaxed);
+    size_t moved = 0;
+    try {
+        for (; moved < n; ++moved) {
+            items[moved] = std::move(*item(front + moved));
+            item(front + moved)->~T();
+        }
+    } catch (...) {
+        // hand back the slots that were emptied before the exception
+        head.store(front + moved, std::memory_order_release);
+        throw;
+    }
+    head.store(front + n, std::memory_order_release);
+    return n;
+}
+
+template <typename T> void BQueue<T, true>::enqueue(const T& new_item)
+{
+    if (!try_enqueue(new_item))
+        throw Overflow();
+}
+
+template <typename T> T BQueue<T, true>::dequeue()
+{
+    if (ready(1) == 0)
+        throw Underflow();
+    size_t front = head.load(std::memory_order_relaxed);
+    T result(std::move(*item(front)));
+    item(front)->~T();
+    head.store(front + 1, std::memory_order_release);
+    return result;
+}
+
+template <typename T> bool BQueue<T, true>::is_empty() const
+{
+    return size() == 0;
+}
+
+template <typename T> bool BQueue<T, true>::is_full() const
+{
+    return size() == capacity();
+}
+
+template <typename T> size_t BQueue<T, true>::size() const
+{
+    size_t front = head.load(std::memory_order_acquire);
+    size_t back = tail.load(std::memory_order_acquire);
+    return std::min(back - front, capacity());
+}
+
+template <typename T> size_t BQueue<T, true>::capacity() const
+{
+    return mask + 1;
+}
+
+#endif // BQUEUE_CPP
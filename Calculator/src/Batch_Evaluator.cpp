@@ -0,0 +1,391 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#include "Batch_Evaluator.h"
+#include "Bytecode.h"
+#include "Interpreter.h"
+#include <algorithm>
+#include <cstring>
+#include <math.h>
+
+// The AVX2 kernels are compiled for AVX2 on their own and only called
+// when the processor supports it, so the rest of the program still
+// runs anywhere.
+#if defined(__x86_64__) && defined(__GNUC__)
+#define BATCH_AVX2 1
+#include <immintrin.h>
+#else
+#define BATCH_AVX2 0
+#endif
+
+namespace {
+
+/**
+ * @struct Kernels
+ * @brief One function per column operation.  Each one handles @a n rows,
+ *        and @a out may be the same column as an input.
+ */
+struct Kernels {
+    void (*negate)(const int* a, int* out, std::size_t n);
+    void (*add)(const int* a, const int* b, int* out, std::size_t n);
+    void (*subtract)(const int* a, const int* b, int* out, std::size_t n);
+    void (*multiply)(const int* a, const int* b, int* out, std::size_t n);
+    // Rows with a zero divisor get 0 and are marked in @a errors, unless
+    // an earlier instruction marked them already.
+    void (*divide)(const int* a, const int* b, int* out, char* errors, std::size_t n);
+    void (*modulus)(const int* a, const int* b, int* out, char* errors, std::size_t n);
+    void (*power)(const int* a, const int* b, int* out, std::size_t n);
+};
+
+void scalar_negate(const int* a, int* out, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = -a[i];
+}
+
+void scalar_add(const int* a, const int* b, int* out, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = a[i] + b[i];
+}
+
+void scalar_subtract(const int* a, const int* b, int* out, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = a[i] - b[i];
+}
+
+void scalar_multiply(const int* a, const int* b, int* out, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = a[i] * b[i];
+}
+
+// Mark a row that went wrong in @a instruction, keeping the first error.
+inline void mark(char& error, Bytecode::Opcode instruction)
+{
+    if (!error)
+        error = instruction;
+}
+
+// Dividing the smallest int by -1 overflows (and traps on x86), so it
+// wraps around like the AVX2 kernel does.
+void scalar_divide(const int* a, const int* b, int* out, char* errors, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        if (b[i] == 0) {
+            mark(errors[i], Bytecode::DIVIDE);
+            out[i] = 0;
+        } else if (b[i] == -1) {
+            out[i] = static_cast<int>(0u - static_cast<unsigned>(a[i]));
+        } else {
+            out[i] = a[i] / b[i];
+        }
+    }
+}
+
+void scalar_modulus(const int* a, const int* b, int* out, char* errors, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        if (b[i] == 0) {
+            mark(errors[i], Bytecode::MODULUS);
+            out[i] = 0;
+        } else if (b[i] == -1) {
+            out[i] = 0;
+        } else {
+            out[i] = a[i] % b[i];
+        }
+    }
+}
+
+// Same conversion as Evaluation_Visitor.
+void scalar_power(const int* a, const int* b, int* out, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = static_cast<int>(pow(a[i], b[i]));
+}
+
+#if BATCH_AVX2
+
+__attribute__((target("avx2"))) void avx2_negate(const int* a, int* out, std::size_t n)
+{
+    std::size_t i = 0;
+    const __m256i zero = _mm256_setzero_si256();
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_sub_epi32(zero, x));
+    }
+    scalar_negate(a + i, out + i, n - i);
+}
+
+__attribute__((target("avx2"))) void avx2_add(const int* a, const int* b, int* out, std::size_t n)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi32(x, y));
+    }
+    scalar_add(a + i, b + i, out + i, n - i);
+}
+
+__attribute__((target("avx2"))) void avx2_subtract(
+    const int* a, const int* b, int* out, std::size_t n)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_sub_epi32(x, y));
+    }
+    scalar_subtract(a + i, b + i, out + i, n - i);
+}
+
+__attribute__((target("avx2"))) void avx2_multiply(
+    const int* a, const int* b, int* out, std::size_t n)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_mullo_epi32(x, y));
+    }
+    scalar_multiply(a + i, b + i, out + i, n - i);
+}
+
+// Truncated quotient of 8 rows.  There is no integer division in AVX2,
+// but a double holds any int exactly and the rounding error of the
+// double quotient is too small to change its integer part.  A zero
+// divisor is replaced by 1 and its row marked in @a zero.
+__attribute__((target("avx2"))) __m256i avx2_quotient(__m256i x, __m256i& y, __m256i& zero)
+{
+    zero = _mm256_cmpeq_epi32(y, _mm256_setzero_si256());
+    y = _mm256_blendv_epi8(y, _mm256_set1_epi32(1), zero);
+    __m256d low = _mm256_div_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(x)),
+        _mm256_cvtepi32_pd(_mm256_castsi256_si128(y)));
+    __m256d high = _mm256_div_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(x, 1)),
+        _mm256_cvtepi32_pd(_mm256_extracti128_si256(y, 1)));
+    return _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm256_cvttpd_epi32(low)), _mm256_cvttpd_epi32(high), 1);
+}
+
+// Mark the rows of @a zero in @a errors.
+__attribute__((target("avx2"))) void avx2_mark(
+    __m256i zero, char* errors, Bytecode::Opcode instruction)
+{
+    int rows = _mm256_movemask_ps(_mm256_castsi256_ps(zero));
+    for (int j = 0; rows != 0; ++j, rows >>= 1)
+        if (rows & 1)
+            mark(errors[j], instruction);
+}
+
+__attribute__((target("avx2"))) void avx2_divide(
+    const int* a, const int* b, int* out, char* errors, std::size_t n)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i zero;
+        __m256i q = avx2_quotient(x, y, zero);
+        avx2_mark(zero, errors + i, Bytecode::DIVIDE);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_andnot_si256(zero, q));
+    }
+    scalar_divide(a + i, b + i, out + i, errors + i, n - i);
+}
+
+__attribute__((target("avx2"))) void avx2_modulus(
+    const int* a, const int* b, int* out, char* errors, std::size_t n)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i zero;
+        __m256i q = avx2_quotient(x, y, zero);
+        __m256i r = _mm256_sub_epi32(x, _mm256_mullo_epi32(q, y));
+        avx2_mark(zero, errors + i, Bytecode::MODULUS);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_andnot_si256(zero, r));
+    }
+    scalar_modulus(a + i, b + i, out + i, errors + i, n - i);
+}
+
+// Exponentiation by squaring in doubles, 4 rows at a time.  Every value
+// is exact as long as the result fits in an int, and a result that
+// doesn't fit converts to the same value pow() would give.  A negative
+// exponent takes the reciprocal.
+__attribute__((target("avx2"))) void avx2_power(
+    const int* a, const int* b, int* out, std::size_t n)
+{
+    std::size_t i = 0;
+    const __m128i one = _mm_set1_epi32(1);
+    for (; i + 4 <= n; i += 4) {
+        __m256d base = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+        __m128i exponent = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        __m128i negative = _mm_cmplt_epi32(exponent, _mm_setzero_si128());
+        // the smallest int stays negative, but is still right as unsigned
+        __m128i bits = _mm_abs_epi32(exponent);
+        __m256d result = _mm256_set1_pd(1.0);
+        while (!_mm_testz_si128(bits, bits)) {
+            __m128i odd = _mm_cmpeq_epi32(_mm_and_si128(bits, one), one);
+            result = _mm256_blendv_pd(result, _mm256_mul_pd(result, base),
+                _mm256_castsi256_pd(_mm256_cvtepi32_epi64(odd)));
+            base = _mm256_mul_pd(base, base);
+            bits = _mm_srli_epi32(bits, 1);
+        }
+        result = _mm256_blendv_pd(result, _mm256_div_pd(_mm256_set1_pd(1.0), result),
+            _mm256_castsi256_pd(_mm256_cvtepi32_epi64(negative)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_cvttpd_epi32(result));
+    }
+    scalar_power(a + i, b + i, out + i, n - i);
+}
+
+#endif // BATCH_AVX2
+
+const Kernels scalar_kernels = { scalar_negate, scalar_add, scalar_subtract, scalar_multiply,
+    scalar_divide, scalar_modulus, scalar_power };
+
+#if BATCH_AVX2
+const Kernels avx2_kernels = { avx2_negate, avx2_add, avx2_subtract, avx2_multiply, avx2_divide,
+    avx2_modulus, avx2_power };
+#endif
+
+// Return the kernels for this processor.
+const Kernels& kernels()
+{
+#if BATCH_AVX2
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if (avx2)
+        return avx2_kernels;
+#endif
+    return scalar_kernels;
+}
+
+} // namespace
+
+Batch_Evaluator::Batch_Evaluator(const Bytecode& bytecode)
+    : bytecode(bytecode)
+{
+}
+
+std::size_t Batch_Evaluator::evaluate(
+    const std::vector<const int*>& columns, std::size_t rows, int* results, char* errors) const
+{
+    const Kernels& kernel = kernels();
+    const std::vector<Bytecode::Instruction>& program = bytecode.program();
+    const std::size_t depth = bytecode.depth();
+
+    // a block of rows for every stack entry and every temporary
+    std::vector<int> storage((depth + bytecode.temporaries()) * block_size);
+    int* const temps = storage.data() + depth * block_size;
+    auto buffer = [&storage](std::size_t entry) { return storage.data() + entry * block_size; };
+    // the column on each stack entry, which is either the entry's own
+    // buffer, a temporary, or an input column
+    std::vector<const int*> stack(depth);
+
+    const int* variables = bytecode.variables() ? bytecode.variables()->data() : nullptr;
+    std::memset(errors, 0, rows);
+
+    for (std::size_t first = 0; first < rows; first += block_size) {
+        const std::size_t n = std::min(block_size, rows - first);
+        char* const block_errors = errors + first;
+        std::size_t top = 0;
+
+        for (const Bytecode::Instruction& instruction : program) {
+            switch (instruction.op) {
+            case Bytecode::NUMBER:
+                std::fill_n(buffer(top), n, instruction.operand);
+                stack[top] = buffer(top);
+                ++top;
+                break;
+            case Bytecode::VARIABLE: {
+                std::size_t slot = static_cast<std::size_t>(instruction.operand);
+                if (slot < columns.size() && columns[slot]) {
+                    stack[top] = columns[slot] + first;
+                } else {
+                    std::fill_n(buffer(top), n, variables[slot]);
+                    stack[top] = buffer(top);
+                }
+                ++top;
+                break;
+            }
+            case Bytecode::LOAD:
+                stack[top++] = temps + instruction.operand * block_size;
+                break;
+            case Bytecode::STORE:
+                std::copy_n(stack[top - 1], n, temps + instruction.operand * block_size);
+                break;
+            case Bytecode::NEGATE:
+                kernel.negate(stack[top - 1], buffer(top - 1), n);
+                stack[top - 1] = buffer(top - 1);
+                break;
+            case Bytecode::FACTORIAL:
+                for (std::size_t i = 0; i < n; ++i) {
+                    int factorial = 1;
+                    for (int j = stack[top - 1][i]; j > 1; --j)
+                        factorial *= j;
+                    buffer(top - 1)[i] = factorial;
+                }
+                stack[top - 1] = buffer(top - 1);
+                break;
+            case Bytecode::ADD:
+                kernel.add(stack[top - 2], stack[top - 1], buffer(top - 2), n);
+                stack[top - 2] = buffer(top - 2);
+                --top;
+                break;
+            case Bytecode::SUBTRACT:
+                kernel.subtract(stack[top - 2], stack[top - 1], buffer(top - 2), n);
+                stack[top - 2] = buffer(top - 2);
+                --top;
+                break;
+            case Bytecode::MULTIPLY:
+                kernel.multiply(stack[top - 2], stack[top - 1], buffer(top - 2), n);
+                stack[top - 2] = buffer(top - 2);
+                --top;
+                break;
+            case Bytecode::DIVIDE:
+                kernel.divide(stack[top - 2], stack[top - 1], buffer(top - 2), block_errors, n);
+                stack[top - 2] = buffer(top - 2);
+                --top;
+                break;
+            case Bytecode::MODULUS:
+                kernel.modulus(stack[top - 2], stack[top - 1], buffer(top - 2), block_errors, n);
+                stack[top - 2] = buffer(top - 2);
+                --top;
+                break;
+            case Bytecode::POWER:
+                kernel.power(stack[top - 2], stack[top - 1], buffer(top - 2), n);
+                stack[top - 2] = buffer(top - 2);
+                --top;
+                break;
+            case Bytecode::RETURN:
+                std::copy_n(stack[top - 1], n, results + first);
+                break;
+            }
+        }
+    }
+
+    // a row that went wrong anywhere in the program has no result
+    std::size_t failed = 0;
+    for (std::size_t row = 0; row < rows; ++row) {
+        if (errors[row]) {
+            results[row] = 0;
+            ++failed;
+        }
+    }
+    return failed;
+}
+
+bool Batch_Evaluator::vectorized()
+{
+#if BATCH_AVX2
+    return &kernels() == &avx2_kernels;
+#else
+    return false;
+#endif
+}
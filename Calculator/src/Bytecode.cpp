@@ -0,0 +1,318 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#include "Bytecode.h"
+#include "Component_Node.h"
+#include "Interpreter.h"
+#include "Leaf_Node.h"
+#include "Variable_Node.h"
+#include "Visitor.h"
+#include <math.h>
+#include <unordered_map>
+#include <utility>
+
+// GCC and Clang can jump straight to the next handler through a table
+// of label addresses, everything else gets a switch.
+#if defined(__GNUC__)
+#define BYTECODE_COMPUTED_GOTO 1
+#else
+#define BYTECODE_COMPUTED_GOTO 0
+#endif
+
+/**
+ * @class Bytecode_Compiler
+ * @brief Visitor that appends the instruction for each node it visits.
+ *        Nodes have to be visited in post-order.
+ */
+class Bytecode_Compiler : public Visitor {
+public:
+    explicit Bytecode_Compiler(Bytecode& bytecode)
+        : bytecode(bytecode)
+        , depth(0)
+    {
+    }
+
+    void visit(const Leaf_Node& node) override
+    {
+        emit(Bytecode::NUMBER, node.item(), 1);
+    }
+
+    void visit(const Variable_Node& node) override
+    {
+        bytecode.context = &node.context();
+        emit(Bytecode::VARIABLE, node.slot(), 1);
+    }
+
+    void visit(const Composite_Negate_Node&) override
+    {
+        emit(Bytecode::NEGATE, 0, 0);
+    }
+
+    void visit(const Composite_Add_Node&) override
+    {
+        emit(Bytecode::ADD, 0, -1);
+    }
+
+    void visit(const Composite_Subtract_Node&) override
+    {
+        emit(Bytecode::SUBTRACT, 0, -1);
+    }
+
+    void visit(const Composite_Divide_Node&) override
+    {
+        emit(Bytecode::DIVIDE, 0, -1);
+    }
+
+    void visit(const Composite_Multiply_Node&) override
+    {
+        emit(Bytecode::MULTIPLY, 0, -1);
+    }
+
+    void visit(const Composite_Modulus_Node&) override
+    {
+        emit(Bytecode::MODULUS, 0, -1);
+    }
+
+    void visit(const Composite_Power_Node&) override
+    {
+        emit(Bytecode::POWER, 0, -1);
+    }
+
+    void visit(const Composite_Factorial_Node&) override
+    {
+        emit(Bytecode::FACTORIAL, 0, 0);
+    }
+
+    // add an instruction that changes the stack size by @a change
+    void emit(Bytecode::Opcode op, int operand, int change)
+    {
+        bytecode.code.push_back(Bytecode::Instruction { op, operand });
+        depth += change;
+        if (depth > bytecode.max_depth)
+            bytecode.max_depth = depth;
+    }
+
+private:
+    Bytecode& bytecode;
+    std::size_t depth;
+};
+
+// Compile in two walks: the first counts the parents of every node, the
+// second emits the program, storing nodes with several parents in a
+// temporary the first time and loading them after that.
+Bytecode::Bytecode(const Component_Node* root)
+    : context(nullptr)
+    , max_depth(0)
+    , temps(0)
+{
+    std::unordered_map<const Component_Node*, int> parents;
+    std::vector<const Component_Node*> nodes { root };
+    while (!nodes.empty()) {
+        const Component_Node* node = nodes.back();
+        nodes.pop_back();
+        // the children of a node are only counted the first time
+        if (++parents[node] == 1) {
+            if (node->right())
+                nodes.push_back(node->right());
+            if (node->left())
+                nodes.push_back(node->left());
+        }
+    }
+
+    Bytecode_Compiler compiler(*this);
+    // temporary of every shared node that has been emitted
+    std::unordered_map<const Component_Node*, int> stored;
+    // post-order walk; the flag is true once the node's children are
+    // on the stack ahead of it
+    std::vector<std::pair<const Component_Node*, bool>> pending { { root, false } };
+
+    while (!pending.empty()) {
+        auto [node, expanded] = pending.back();
+        pending.pop_back();
+
+        auto iter = stored.find(node);
+        if (iter != stored.end()) {
+            compiler.emit(LOAD, iter->second, 1);
+        } else if (!expanded) {
+            pending.emplace_back(node, true);
+            if (node->right())
+                pending.emplace_back(node->right(), false);
+            if (node->left())
+                pending.emplace_back(node->left(), false);
+        } else {
+            node->accept(compiler);
+            if (parents[node] > 1) {
+                int temp = static_cast<int>(temps++);
+                compiler.emit(STORE, temp, 0);
+                stored.emplace(node, temp);
+            }
+        }
+    }
+
+    compiler.emit(RETURN, 0, 0);
+}
+
+bool Bytecode::evaluate(int& result) const
+{
+    // the slot array can move as variables are added, so read it now
+    return evaluate(context ? context->data() : nullptr, result);
+}
+
+bool Bytecode::evaluate(const int* variables, int& result, Opcode* failed) const
+{
+    // most programs fit in a few values, so only big ones allocate
+    const std::size_t small = 64;
+    int small_stack[small];
+    int small_temps[small];
+    std::vector<int> large_stack;
+    std::vector<int> large_temps;
+
+    int* sp = small_stack;
+    if (max_depth > small) {
+        large_stack.resize(max_depth);
+        sp = large_stack.data();
+    }
+    int* temp = small_temps;
+    if (temps > small) {
+        large_temps.resize(temps);
+        temp = large_temps.data();
+    }
+
+    const Instruction* pc = code.data();
+
+#if BYTECODE_COMPUTED_GOTO
+    // must be in the same order as Opcode
+    static void* const labels[] = { &&NUMBER_op, &&VARIABLE_op, &&LOAD_op, &&STORE_op,
+        &&NEGATE_op, &&FACTORIAL_op, &&ADD_op, &&SUBTRACT_op, &&MULTIPLY_op, &&DIVIDE_op,
+        &&MODULUS_op, &&POWER_op, &&RETURN_op };
+#define VM_CASE(op) op##_op:
+#define VM_NEXT() goto* labels[(++pc)->op]
+    goto* labels[pc->op];
+#else
+#define VM_CASE(op) case op:
+#define VM_NEXT()                                                                                  \
+    {                                                                                              \
+        ++pc;                                                                                      \
+        continue;                                                                                  \
+    }
+    for (;;)
+        switch (pc->op) {
+#endif
+
+    VM_CASE(NUMBER)
+    {
+        *sp++ = pc->operand;
+        VM_NEXT();
+    }
+    VM_CASE(VARIABLE)
+    {
+        *sp++ = variables[pc->operand];
+        VM_NEXT();
+    }
+    VM_CASE(LOAD)
+    {
+        *sp++ = temp[pc->operand];
+        VM_NEXT();
+    }
+    VM_CASE(STORE)
+    {
+        temp[pc->operand] = sp[-1];
+        VM_NEXT();
+    }
+    VM_CASE(NEGATE)
+    {
+        sp[-1] = -sp[-1];
+        VM_NEXT();
+    }
+    VM_CASE(FACTORIAL)
+    {
+        int factorial = 1;
+        for (int i = sp[-1]; i > 1; --i)
+            factorial *= i;
+        sp[-1] = factorial;
+        VM_NEXT();
+    }
+    VM_CASE(ADD)
+    {
+        --sp;
+        sp[-1] += sp[0];
+        VM_NEXT();
+    }
+    VM_CASE(SUBTRACT)
+    {
+        --sp;
+        sp[-1] -= sp[0];
+        VM_NEXT();
+    }
+    VM_CASE(MULTIPLY)
+    {
+        --sp;
+        sp[-1] *= sp[0];
+        VM_NEXT();
+    }
+    VM_CASE(DIVIDE)
+    {
+        if (sp[-1] == 0) {
+            if (failed)
+                *failed = DIVIDE;
+            return false;
+        }
+        --sp;
+        sp[-1] /= sp[0];
+        VM_NEXT();
+    }
+    VM_CASE(MODULUS)
+    {
+        if (sp[-1] == 0) {
+            if (failed)
+                *failed = MODULUS;
+            return false;
+        }
+        --sp;
+        sp[-1] %= sp[0];
+        VM_NEXT();
+    }
+    VM_CASE(POWER)
+    {
+        --sp;
+        // same conversion as Evaluation_Visitor
+        sp[-1] = static_cast<int>(pow(sp[-1], sp[0]));
+        VM_NEXT();
+    }
+    VM_CASE(RETURN)
+    {
+        result = sp[-1];
+        return true;
+    }
+
+#if !BYTECODE_COMPUTED_GOTO
+        }
+#endif
+#undef VM_CASE
+#undef VM_NEXT
+}
+
+const std::vector<Bytecode::Instruction>& Bytecode::program() const
+{
+    return code;
+}
+
+std::size_t Bytecode::depth() const
+{
+    return max_depth;
+}
+
+std::size_t Bytecode::temporaries() const
+{
+    return temps;
+}
+
+const Interpreter_Context* Bytecode::variables() const
+{
+    return context;
+}
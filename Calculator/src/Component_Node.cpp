@@ -1,5 +1,15 @@
 
 #include "Component_Node.h"
+#include <algorithm>
+#include <limits>
+
+Component_Node::Component_Node()
+    : nodes(1)
+    , levels(1)
+    , parent_node(nullptr)
+    , linked(true)
+{
+}
 
 // default left is to return a null pointer
 Component_Node* Component_Node::left() const
@@ -12,3 +22,42 @@ Component_Node* Component_Node::right() const
 {
     return nullptr;
 }
+
+std::size_t Component_Node::size() const
+{
+    return nodes;
+}
+
+std::size_t Component_Node::height() const
+{
+    return levels;
+}
+
+const Component_Node* Component_Node::parent() const
+{
+    return parent_node;
+}
+
+bool Component_Node::threaded() const
+{
+    return linked;
+}
+
+void Component_Node::add_child(Component_Node* child)
+{
+    if (child) {
+        nodes += std::min(child->nodes, std::numeric_limits<std::size_t>::max() - nodes);
+        levels = std::max(levels, child->levels + 1);
+        // a shared child keeps its first parent, so a walk up from it
+        // wouldn't come back to this node
+        linked = linked && child->linked && !child->parent_node;
+        if (!child->parent_node)
+            child->parent_node = this;
+    }
+}
+
+void Component_Node::remove_child(Component_Node* child)
+{
+    if (child && child->parent_node == this)
+        child->parent_node = nullptr;
+}
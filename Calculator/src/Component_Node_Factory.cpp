@@ -0,0 +1,159 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#include "Component_Node_Factory.h"
+#include "Composite_Add_Node.h"
+#include "Composite_Divide_Node.h"
+#include "Composite_Factorial_Node.h"
+#include "Composite_Modulus_Node.h"
+#include "Composite_Multiply_Node.h"
+#include "Composite_Negate_Node.h"
+#include "Composite_Power_Node.h"
+#include "Composite_Subtract_Node.h"
+#include "Leaf_Node.h"
+#include "Variable_Node.h"
+#include <functional>
+
+// Ctor
+Component_Node_Factory::Component_Node_Factory(bool share)
+    : share(share)
+{
+}
+
+bool Component_Node_Factory::Key::operator==(const Key& rhs) const
+{
+    return op == rhs.op && value == rhs.value && left == rhs.left && right == rhs.right;
+}
+
+// combine the fields the same way boost::hash_combine does
+std::size_t Component_Node_Factory::Key_Hash::operator()(const Key& key) const
+{
+    std::size_t hash = std::hash<int>()(key.op);
+    hash ^= std::hash<int>()(key.value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<const void*>()(key.left) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<const void*>()(key.right) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+Component_Node_Factory::Node* Component_Node_Factory::find(const Key& key)
+{
+    if (!share)
+        return nullptr;
+
+    auto iter = nodes.find(key);
+    return iter == nodes.end() ? nullptr : &iter->second;
+}
+
+Component_Node_Factory::Node Component_Node_Factory::add(const Key& key, Component_Node* node)
+{
+    Node result(node);
+    if (share)
+        nodes.emplace(key, result);
+    return result;
+}
+
+Component_Node_Factory::Node Component_Node_Factory::make_number(int value)
+{
+    Key key { '#', value, nullptr, nullptr };
+    if (Node* node = find(key))
+        return *node;
+    return add(key, new Leaf_Node(value));
+}
+
+Component_Node_Factory::Node Component_Node_Factory::make_variable(
+    const Interpreter_Context& context, int slot)
+{
+    Key key { '$', slot, nullptr, nullptr };
+    if (Node* node = find(key))
+        return *node;
+    return add(key, new Variable_Node(context, slot));
+}
+
+Component_Node_Factory::Node Component_Node_Factory::make_negate(const Node& right)
+{
+    Key key { '~', 0, nullptr, right.get_ptr() };
+    if (Node* node = find(key))
+        return *node;
+    return add(key, new Composite_Negate_Node(right));
+}
+
+Component_Node_Factory::Node Component_Node_Factory::make_factorial(const Node& left)
+{
+    Key key { '!', 0, left.get_ptr(), nullptr };
+    if (Node* node = find(key))
+        return *node;
+    return add(key, new Composite_Factorial_Node(left));
+}
+
+Component_Node_Factory::Node Component_Node_Factory::make_add(const Node& left, const Node& right)
+{
+    Key key { '+', 0, left.get_ptr(), right.get_ptr() };
+    if (Node* node = find(key))
+        return *node;
+    return add(key, new Composite_Add_Node(left, right));
+}
+
+Component_Node_Factory::Node Component_Node_Factory::make_subtract(
+    const Node& left, const Node& right)
+{
+    Key key { '-', 0, left.get_ptr(), right.get_ptr() };
+    if (Node* node = find(key))
+        return *node;
+    return add(key, new Composite_Subtract_Node(left, right));
+}
+
+Component_Node_Factory::Node Component_Node_Factory::make_multiply(
+    const Node& left, const Node& right)
+{
+    Key key { '*', 0, left.get_ptr(), right.get_ptr() };
+    if (Node* node = find(key))
+        return *node;
+    return add(key, new Composite_Multiply_Node(left, right));
+}
+
+Component_Node_Factory::Node Component_Node_Factory::make_divide(
+    const Node& left, const Node& right)
+{
+    Key key { '/', 0, left.get_ptr(), right.get_ptr() };
+    if (Node* node = find(key))
+        return *node;
+    return add(key, new Composite_Divide_Node(left, right));
+}
+
+Component_Node_Factory::Node Component_Node_Factory::make_modulus(
+    const Node& left, const Node& right)
+{
+    Key key { '%', 0, left.get_ptr(), right.get_ptr() };
+    if (Node* node = find(key))
+        return *node;
+    return add(key, new Composite_Modulus_Node(left, right));
+}
+
+Component_Node_Factory::Node Component_Node_Factory::make_power(
+    const Node& left, const Node& right)
+{
+    Key key { '^', 0, left.get_ptr(), right.get_ptr() };
+    if (Node* node = find(key))
+        return *node;
+    return add(key, new Composite_Power_Node(left, right));
+}
+
+bool Component_Node_Factory::sharing() const
+{
+    return share;
+}
+
+std::size_t Component_Node_Factory::size() const
+{
+    return nodes.size();
+}
+
+void Component_Node_Factory::clear()
+{
+    nodes.clear();
+}
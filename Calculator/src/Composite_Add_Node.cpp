@@ -3,7 +3,8 @@
 #include "Visitor.h"
 
 // Ctor
-Composite_Add_Node::Composite_Add_Node(Component_Node* left, Component_Node* right)
+Composite_Add_Node::Composite_Add_Node(
+    const Refcounter<Component_Node>& left, const Refcounter<Component_Node>& right)
     : Composite_Binary_Node(left, right)
 {
 }
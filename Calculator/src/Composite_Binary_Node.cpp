@@ -2,14 +2,22 @@
 #include "Composite_Binary_Node.h"
 
 // Ctor
-Composite_Binary_Node::Composite_Binary_Node(Component_Node* left, Component_Node* right)
+Composite_Binary_Node::Composite_Binary_Node(
+    const Refcounter<Component_Node>& left, const Refcounter<Component_Node>& right)
     : Composite_Unary_Node(right)
     , leftChild(left)
 {
+    add_child(leftChild.get_ptr());
+}
+
+// Dtor
+Composite_Binary_Node::~Composite_Binary_Node()
+{
+    remove_child(leftChild.get_ptr());
 }
 
 // Return the left child pointer
 Component_Node* Composite_Binary_Node::left() const
 {
-    return leftChild.get();
+    return leftChild.get_ptr();
 }
@@ -3,7 +3,8 @@
 #include "Visitor.h"
 
 // Ctor
-Composite_Divide_Node::Composite_Divide_Node(Component_Node* left, Component_Node* right)
+Composite_Divide_Node::Composite_Divide_Node(
+    const Refcounter<Component_Node>& left, const Refcounter<Component_Node>& right)
     : Composite_Binary_Node(left, right)
 {
 }
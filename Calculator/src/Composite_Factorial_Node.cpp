@@ -3,7 +3,7 @@
 #include "Visitor.h"
 
 // Ctor
-Composite_Factorial_Node::Composite_Factorial_Node(Component_Node* left)
+Composite_Factorial_Node::Composite_Factorial_Node(const Refcounter<Component_Node>& left)
     : Composite_Left_Node(left)
 {
 }
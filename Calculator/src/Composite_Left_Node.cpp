@@ -9,14 +9,21 @@
 #include "Composite_Left_Node.h"
 
 // Ctor
-Composite_Left_Node::Composite_Left_Node(Component_Node* left)
+Composite_Left_Node::Composite_Left_Node(const Refcounter<Component_Node>& left)
     : Component_Node()
     , leftChild(left)
 {
+    add_child(leftChild.get_ptr());
+}
+
+// Dtor
+Composite_Left_Node::~Composite_Left_Node()
+{
+    remove_child(leftChild.get_ptr());
 }
 
 // Return the right child pointer
 Component_Node* Composite_Left_Node::left() const
 {
-    return leftChild.get();
+    return leftChild.get_ptr();
 }
@@ -10,7 +10,8 @@
 #include "Visitor.h"
 
 // Ctor
-Composite_Modulus_Node::Composite_Modulus_Node(Component_Node* left, Component_Node* right)
+Composite_Modulus_Node::Composite_Modulus_Node(
+    const Refcounter<Component_Node>& left, const Refcounter<Component_Node>& right)
     : Composite_Binary_Node(left, right)
 {
 }
@@ -3,7 +3,8 @@
 #include "Visitor.h"
 
 // Ctor
-Composite_Multiply_Node::Composite_Multiply_Node(Component_Node* left, Component_Node* right)
+Composite_Multiply_Node::Composite_Multiply_Node(
+    const Refcounter<Component_Node>& left, const Refcounter<Component_Node>& right)
     : Composite_Binary_Node(left, right)
 {
 }
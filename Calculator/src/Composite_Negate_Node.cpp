@@ -3,7 +3,7 @@
 #include "Visitor.h"
 
 // Ctor
-Composite_Negate_Node::Composite_Negate_Node(Component_Node* right)
+Composite_Negate_Node::Composite_Negate_Node(const Refcounter<Component_Node>& right)
     : Composite_Unary_Node(right)
 {
 }
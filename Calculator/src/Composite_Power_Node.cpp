@@ -9,7 +9,8 @@
 #include "Visitor.h"
 
 // Ctor
-Composite_Power_Node::Composite_Power_Node(Component_Node* left, Component_Node* right)
+Composite_Power_Node::Composite_Power_Node(
+    const Refcounter<Component_Node>& left, const Refcounter<Component_Node>& right)
     : Composite_Binary_Node(left, right)
 {
 }
@@ -3,7 +3,8 @@
 #include "Visitor.h"
 
 // Ctor
-Composite_Subtract_Node::Composite_Subtract_Node(Component_Node* left, Component_Node* right)
+Composite_Subtract_Node::Composite_Subtract_Node(
+    const Refcounter<Component_Node>& left, const Refcounter<Component_Node>& right)
     : Composite_Binary_Node(left, right)
 {
 }
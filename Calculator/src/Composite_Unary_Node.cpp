@@ -2,14 +2,21 @@
 #include "Composite_Unary_Node.h"
 
 // Ctor
-Composite_Unary_Node::Composite_Unary_Node(Component_Node* right)
+Composite_Unary_Node::Composite_Unary_Node(const Refcounter<Component_Node>& right)
     : Component_Node()
     , rightChild(right)
 {
+    add_child(rightChild.get_ptr());
+}
+
+// Dtor
+Composite_Unary_Node::~Composite_Unary_Node()
+{
+    remove_child(rightChild.get_ptr());
 }
 
 // Return the right child pointer
 Component_Node* Composite_Unary_Node::right() const
 {
-    return rightChild.get();
+    return rightChild.get_ptr();
 }
@@ -0,0 +1,79 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#include "Connection_Queue.h"
+#include "Expression_Tree_Event_Handler.h"
+#include "Options.h"
+#include "Reactor.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+// Most connections taken from the queue at once.
+static const std::size_t BATCH = 16;
+
+Connection_Queue::Connection_Queue(std::size_t size)
+    : connections(size)
+    , handle(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+{
+    if (handle < 0)
+        throw std::domain_error(std::string("Can't make an eventfd: ") + std::strerror(errno));
+}
+
+Connection_Queue::~Connection_Queue()
+{
+    int connection;
+    while (connections.try_dequeue(connection))
+        close(connection);
+    close(handle);
+}
+
+bool Connection_Queue::hand_off(int connection)
+{
+    if (!connections.try_enqueue(connection))
+        return false;
+
+    // the counter only overflows after 2^64 - 1 writes nobody read
+    std::uint64_t one = 1;
+    while (write(handle, &one, sizeof(one)) < 0 && errno == EINTR)
+        continue;
+    return true;
+}
+
+int Connection_Queue::get_handle() const
+{
+    return handle;
+}
+
+void Connection_Queue::handle_input()
+{
+    // reset the counter before taking the connections, so one handed
+    // off in between wakes us up again
+    std::uint64_t count;
+    while (read(handle, &count, sizeof(count)) < 0 && errno == EINTR)
+        continue;
+
+    int waiting[BATCH];
+    while (std::size_t taken = connections.try_dequeue(waiting, BATCH)) {
+        for (std::size_t i = 0; i < taken; ++i) {
+            Event_Handler* session = Expression_Tree_Event_Handler::make_handler(
+                Options::instance()->verbose(), waiting[i], Options::instance()->framed());
+            try {
+                Reactor::instance()->register_input_handler(session);
+            } catch (std::domain_error& e) {
+                std::cerr << "ERROR: " << e.what() << std::endl;
+                delete session;
+            }
+        }
+    }
+}
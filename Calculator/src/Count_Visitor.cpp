@@ -9,12 +9,17 @@
 #include "Composite_Power_Node.h"
 #include "Composite_Subtract_Node.h"
 #include "Leaf_Node.h"
+#include "Variable_Node.h"
 #include <iostream>
 
 void Count_Visitor::visit(const Leaf_Node& node)
 {
 }
 
+void Count_Visitor::visit(const Variable_Node&)
+{
+}
+
 void Count_Visitor::visit(const Composite_Negate_Node& node)
 {
     count["-(Negation)"] += 1;
@@ -9,16 +9,28 @@
 #include "Composite_Power_Node.h"
 #include "Composite_Subtract_Node.h"
 #include "Leaf_Node.h"
+#include "Variable_Node.h"
 #include <iostream>
 #include <math.h>
 #include <memory>
 
+Evaluation_Visitor::Evaluation_Visitor(std::ostream& errors)
+    : errors(errors)
+{
+}
+
 // base evaluation for a node. This is used by Leaf_Node
 void Evaluation_Visitor::visit(const Leaf_Node& node)
 {
     stack.push(node.item());
 }
 
+// evaluation of a variable reads its current value (Variable_Node)
+void Evaluation_Visitor::visit(const Variable_Node& node)
+{
+    stack.push(node.item());
+}
+
 // evaluation of a negation (Composite_Negate_Node)
 void Evaluation_Visitor::visit(const Composite_Negate_Node&)
 {
@@ -63,8 +75,8 @@ void Evaluation_Visitor::visit(const Composite_Divide_Node&)
         stack.pop();
         stack.push(lhs / rhs);
     } else {
-        std::cout << "\n\n**ERROR**: Division by zero is not allowed. ";
-        std::cout << "Resetting evaluation visitor.\n\n";
+        errors << "\n\n**ERROR**: Division by zero is not allowed. ";
+        errors << "Resetting evaluation visitor.\n\n";
         reset();
     }
 }
@@ -83,15 +95,15 @@ void Evaluation_Visitor::visit(const Composite_Multiply_Node&)
 // evaluations of a modulus (Composite_Modulus_Node)
 void Evaluation_Visitor::visit(const Composite_Modulus_Node& node)
 {
-    if (stack.size() >= 2) {
+    if (stack.size() >= 2 && stack.top()) {
         auto rhs = stack.top();
         stack.pop();
         auto lhs = stack.top();
         stack.pop();
         stack.push(lhs % rhs);
     } else {
-        std::cout << "\n\n**ERROR**: Modulus by zero is not allowed. ";
-        std::cout << "Resetting evaluation visitor.\n\n";
+        errors << "\n\n**ERROR**: Modulus by zero is not allowed. ";
+        errors << "Resetting evaluation visitor.\n\n";
         reset();
     }
 }
@@ -124,7 +136,7 @@ void Evaluation_Visitor::visit(const Composite_Factorial_Node& node)
 // print a total for the evaluation
 int Evaluation_Visitor::total()
 {
-    if (!stack.empty())
+    if (!stack.is_empty())
         return stack.top();
     else
         return 0;
@@ -133,6 +145,16 @@ int Evaluation_Visitor::total()
 // reset the evaluation
 void Evaluation_Visitor::reset()
 {
-    while (!stack.empty())
+    while (!stack.is_empty())
         stack.pop();
 }
+
+void Evaluation_Visitor::push(int value)
+{
+    stack.push(value);
+}
+
+std::size_t Evaluation_Visitor::size() const
+{
+    return stack.size();
+}
@@ -9,7 +9,10 @@
 #include <stdexcept>
 #include <string>
 
+#include "Bytecode.h"
+#include "Flat_Tree.h"
 #include "Component_Node.h"
+#include "Native_Code.h"
 #include "Expression_Tree.h"
 #include "Expression_Tree_Iterator.h"
 #include "Expression_Tree_Iterator_Impl.h"
@@ -130,9 +133,18 @@ Expression_Tree::Expression_Tree(Component_Node* inRoot, bool increase_count)
 {
 }
 
+// Ctor that shares a reference counted root.
+Expression_Tree::Expression_Tree(const Refcounter<Component_Node>& inRoot)
+    : root(inRoot)
+{
+}
+
 // Copy ctor
 Expression_Tree::Expression_Tree(const Expression_Tree& t)
     : root(t.root)
+    , code(t.code)
+    , native(t.native)
+    , flat_tree(t.flat_tree)
 {
 }
 
@@ -141,8 +153,12 @@ Expression_Tree& Expression_Tree::operator=(const Expression_Tree& t)
 {
     // Refcounter class takes care of the internal decrements and
     // increments.
-    if (this != &t)
+    if (this != &t) {
         root = t.root;
+        code = t.code;
+        native = t.native;
+        flat_tree = t.flat_tree;
+    }
     return *this;
 }
 
@@ -163,6 +179,12 @@ Component_Node* Expression_Tree::get_root()
     return root.get_ptr();
 }
 
+// return const root pointer
+const Component_Node* Expression_Tree::get_root() const
+{
+    return root.get_ptr();
+}
+
 // Return the stored item.
 int Expression_Tree::item() const
 {
@@ -225,4 +247,28 @@ void Expression_Tree::accept(Visitor& visitor) const
     root->accept(visitor);
 }
 
+// Compile the tree the first time it's needed.
+const Bytecode& Expression_Tree::bytecode() const
+{
+    if (!code)
+        code = std::make_shared<const Bytecode>(root.get_ptr());
+    return *code;
+}
+
+// Translate the bytecode the first time it's needed.
+const Native_Code& Expression_Tree::native_code() const
+{
+    if (!native)
+        native = std::make_shared<const Native_Code>(bytecode());
+    return *native;
+}
+
+// Flatten the tree the first time it's needed.
+const Flat_Tree& Expression_Tree::flat() const
+{
+    if (!flat_tree)
+        flat_tree = std::make_shared<const Flat_Tree>(root.get_ptr());
+    return *flat_tree;
+}
+
 #endif // EXPRESSION_TREE_CPP
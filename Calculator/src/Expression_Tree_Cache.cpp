@@ -0,0 +1,123 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#include "Expression_Tree_Cache.h"
+#include "Tokenizer.h"
+#include <stdexcept>
+
+// Ctor
+Expression_Tree_Cache::Expression_Tree_Cache(std::size_t capacity)
+    : max_size(capacity)
+    , hit_count(0)
+    , miss_count(0)
+    , eviction_count(0)
+{
+}
+
+// Build a whitespace-insensitive key out of the tokens of an expression.
+// Whitespace can't just be stripped, since "1 2" is an error while "12"
+// is a number.
+std::string Expression_Tree_Cache::normalize(std::string_view expression)
+{
+    std::string key;
+    key.reserve(expression.size());
+    normalize(expression, key);
+    return key;
+}
+
+void Expression_Tree_Cache::normalize(std::string_view expression, std::string& key)
+{
+    key.clear();
+    Tokenizer tokenizer(expression);
+
+    try {
+        for (auto token = tokenizer.next(); token.kind != Tokenizer::END;
+             token = tokenizer.next()) {
+            if (!key.empty())
+                key += ' ';
+            key += token.text;
+        }
+    } catch (const std::domain_error&) {
+        // let the interpreter report the bad symbol
+        key.clear();
+    }
+}
+
+const Expression_Tree* Expression_Tree_Cache::find(const std::string& key)
+{
+    if (max_size == 0 || key.empty())
+        return nullptr;
+
+    auto iter = index.find(key);
+    if (iter == index.end()) {
+        ++miss_count;
+        return nullptr;
+    }
+
+    ++hit_count;
+    // move the entry to the front without copying it
+    entries.splice(entries.begin(), entries, iter->second);
+    return &iter->second->tree;
+}
+
+const Expression_Tree* Expression_Tree_Cache::insert(
+    const std::string& key, const Expression_Tree& tree)
+{
+    if (max_size == 0 || key.empty())
+        return nullptr;
+    auto iter = index.find(key);
+    if (iter != index.end())
+        return &iter->second->tree;
+
+    if (entries.size() == max_size) {
+        index.erase(entries.back().key);
+        entries.pop_back();
+        ++eviction_count;
+    }
+
+    entries.push_front(Entry { key, tree });
+    index.emplace(entries.front().key, entries.begin());
+    return &entries.front().tree;
+}
+
+void Expression_Tree_Cache::clear()
+{
+    index.clear();
+    entries.clear();
+}
+
+std::size_t Expression_Tree_Cache::size() const
+{
+    return entries.size();
+}
+
+std::size_t Expression_Tree_Cache::capacity() const
+{
+    return max_size;
+}
+
+std::size_t Expression_Tree_Cache::hits() const
+{
+    return hit_count;
+}
+
+std::size_t Expression_Tree_Cache::misses() const
+{
+    return miss_count;
+}
+
+std::size_t Expression_Tree_Cache::evictions() const
+{
+    return eviction_count;
+}
+
+void Expression_Tree_Cache::print(std::ostream& out) const
+{
+    out << "cache: " << size() << "/" << capacity() << " trees, " << hits() << " hits, "
+        << misses() << " misses, " << evictions() << " evictions" << std::endl;
+}
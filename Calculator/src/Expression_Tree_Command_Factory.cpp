@@ -87,4 +87,9 @@ Expression_Tree_Command Expression_Tree_Command_Factory::make_history_command(co
     return factory_impl->make_history_command(s);
 }
 
+Expression_Tree_Command Expression_Tree_Command_Factory::make_stats_command(const std::string& s)
+{
+    return factory_impl->make_stats_command(s);
+}
+
 #endif // EXPRESSION_TREE_COMMAND_FACTORY_H
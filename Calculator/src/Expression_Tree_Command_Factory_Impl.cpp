@@ -58,6 +58,12 @@ Expression_Tree_Command Concrete_Expression_Tree_Command_Factory_Impl::make_hist
     return Expression_Tree_Command(new History_Command(tree_context));
 }
 
+Expression_Tree_Command Concrete_Expression_Tree_Command_Factory_Impl::make_stats_command(
+    const std::string&)
+{
+    return Expression_Tree_Command(new Stats_Command(tree_context));
+}
+
 Expression_Tree_Command Concrete_Expression_Tree_Command_Factory_Impl::make_quit_command(
     const std::string&)
 {
@@ -89,6 +95,7 @@ Concrete_Expression_Tree_Command_Factory_Impl::Concrete_Expression_Tree_Command_
     command_map["get"] = &Expression_Tree_Command_Factory_Impl::make_get_command;
     command_map["list"] = &Expression_Tree_Command_Factory_Impl::make_list_command;
     command_map["history"] = &Expression_Tree_Command_Factory_Impl::make_history_command;
+    command_map["stats"] = &Expression_Tree_Command_Factory_Impl::make_stats_command;
     command_map["quit"] = &Expression_Tree_Command_Factory_Impl::make_quit_command;
 }
 
@@ -111,6 +111,17 @@ bool History_Command::execute()
     return true;
 }
 
+Stats_Command::Stats_Command(Expression_Tree_Context& context)
+    : Expression_Tree_Command_Impl(context)
+{
+}
+
+bool Stats_Command::execute()
+{
+    tree_context.stats();
+    return true;
+}
+
 Quit_Command::Quit_Command(Expression_Tree_Context& context)
     : Expression_Tree_Command_Impl(context)
 {
@@ -134,7 +145,7 @@ bool Macro_Command::execute()
         std::for_each(macro_commands_.begin(), macro_commands_.end(),
                       std::mem_fn(&Expression_Tree_Command::execute));
     } catch (std::domain_error& e) {
-        std::cout << "\nERROR: " << e.what() << std::endl;
+        tree_context.out() << "\nERROR: " << e.what() << std::endl;
         return true;
     }
 
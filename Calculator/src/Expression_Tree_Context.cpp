@@ -6,13 +6,18 @@
 // Honor statement: I have neither given nor received any unauthorized aid on this assignment.
 // Assignment Number: Project #7
 
-In the Expression Tree application a user is in succinct mode.  Imagine the moment the user hits enter on the keyboard after typing in a valid expression.  In what order would we encounter the following patterns while executing from that moment until when the program prints out the correct answer: #include "Expression_Tree_Context.h"
+#include "Expression_Tree_Context.h"
+#include "Options.h"
 #include <cstdlib>
+#include <utility>
 
-Expression_Tree_Context::Expression_Tree_Context()
-    : treeState(new Uninitialized_State)
+Expression_Tree_Context::Expression_Tree_Context(std::ostream& output)
+    : interpreter(Options::instance()->share_subtrees(), output)
+    , cache(Options::instance()->cache_capacity())
+    , treeState(new Uninitialized_State)
     , isFormatted(false)
     , isSet(false)
+    , output(output)
 {
 }
 
@@ -41,6 +46,25 @@ void Expression_Tree_Context::evaluate(const std::string& format)
     treeState->evaluate(*this, format);
 }
 
+void Expression_Tree_Context::evaluate_expression(const std::string& expression)
+{
+    // any state takes the format
+    isFormatted = true;
+    try {
+        const Expression_Tree* tree;
+        try {
+            tree = &In_Order_Uninitialized_State::build_tree(*this, expression);
+        } catch (std::domain_error&) {
+            enter_state<In_Order_Uninitialized_State>();
+            throw;
+        }
+        enter_state<In_Order_Initialized_State>();
+        Expression_Tree_State::evaluate_tree(*this, *tree, "post-order");
+    } catch (std::domain_error& e) {
+        output << "\nERROR: " << e.what() << '\n';
+    }
+}
+
 void Expression_Tree_Context::make_set(const std::string& expression)
 {
     treeState->set(*this, expression);
@@ -77,32 +101,33 @@ void Expression_Tree_Context::set(const std::string& key_value_pair)
 
 void Expression_Tree_Context::get(const std::string& val)
 {
-    try {
-        if (int_context.get(val) == 0) {
-            throw std::domain_error("Error: unknown variable \"" + val + "\"\n");
-        } else
-            std::cout << val << ": " << int_context.get(val) << std::endl;
-    } catch (std::domain_error&) {
-        std::cout << "Error: unknown variable \"" << val << "\"" << std::endl;
-    }
+    // look the name up without giving it a slot
+    int slot = int_context.find(val);
+    if (slot == -1 || !int_context.exist(val))
+        output << "Error: unknown variable \"" << val << "\"" << std::endl;
+    else
+        output << val << ": " << int_context.get(slot) << std::endl;
 }
 
 void Expression_Tree_Context::list()
 {
-    int_context.print();
+    int_context.print(output);
 }
 
 void Expression_Tree_Context::history()
 {
-    LQueue<std::string> tmp(commands);
-    while (tmp.size() > 5) {
-        tmp.dequeue();
+    // show the last five commands without copying the history
+    const LQueue<std::string>& past = commands;
+    size_t skip = past.size() > 5 ? past.size() - 5 : 0;
+    int i = 1;
+    for (LQueue<std::string>::const_iterator it(past, skip); it != past.end(); ++it) {
+        output << i++ << ") " << *it << std::endl;
     }
+}
 
-    int size = tmp.size();
-    for (int i = 1; i <= size; i++) {
-        std::cout << i << ") " << tmp.dequeue() << std::endl;
-    }
+void Expression_Tree_Context::stats()
+{
+    cache.print(output);
 }
 
 void Expression_Tree_Context::addToCommands(const std::string& input)
@@ -110,6 +135,23 @@ void Expression_Tree_Context::addToCommands(const std::string& input)
     commands.enqueue(input);
 }
 
+void Expression_Tree_Context::addToCommands(std::string&& input)
+{
+    commands.enqueue(std::move(input));
+}
+
+std::ostream& Expression_Tree_Context::out()
+{
+    return output;
+}
+
+Thread_Pool& Expression_Tree_Context::fork_join_pool()
+{
+    if (!fork_join)
+        fork_join.reset(new Thread_Pool(Options::instance()->fork_join_threads()));
+    return *fork_join;
+}
+
 Expression_Tree_State* Expression_Tree_Context::state() const
 {
     return treeState.get();
@@ -12,23 +12,205 @@
 #include "Expression_Tree_Event_Handler.h"
 #include "Options.h"
 #include "Reactor.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <fcntl.h>
 #include <iostream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <utility>
 
-Expression_Tree_Event_Handler* Expression_Tree_Event_Handler::make_handler(bool verbose)
+// Bytes read from the handle at a time, and at most while the rest of
+// a large frame is on its way.
+static const std::string::size_type READ_SIZE = 4096;
+static const std::string::size_type MAX_READ_SIZE = 64 * 1024;
+
+// Output a connection may pile up before it's sent between commands.
+static const std::size_t FLUSH_SIZE = 64 * 1024;
+
+// How long a closing connection waits for the client to close its end.
+static const std::chrono::milliseconds LINGER_TIME(5000);
+
+// Size of the length before a frame or a command, and the largest
+// frame a client may send.
+static const std::size_t LENGTH_SIZE = 4;
+static const std::size_t MAX_FRAME_SIZE = 16 * 1024 * 1024;
+
+// Return the big-endian length at @a bytes.
+static std::size_t get_length(const char* bytes)
+{
+    std::size_t length = 0;
+    for (std::size_t i = 0; i < LENGTH_SIZE; ++i)
+        length = length << 8 | static_cast<unsigned char>(bytes[i]);
+    return length;
+}
+
+// Write @a length over the placeholder at @a offset of @a output.
+static void put_length(Output_Buffer& output, std::size_t offset, std::size_t length)
+{
+    char bytes[LENGTH_SIZE];
+    for (std::size_t i = LENGTH_SIZE; i-- > 0; length >>= 8)
+        bytes[i] = static_cast<char>(length & 0xff);
+    output.replace(offset, bytes, LENGTH_SIZE);
+}
+
+Expression_Tree_Event_Handler* Expression_Tree_Event_Handler::make_handler(
+    bool verbose, int handle, bool framed)
 {
     if (verbose)
-        return new Verbose_Expression_Tree_Event_Handler;
+        return new Verbose_Expression_Tree_Event_Handler(handle, framed);
     else
-        return new Macro_Command_Expression_Tree_Event_Handler;
+        return new Macro_Command_Expression_Tree_Event_Handler(handle, framed);
+}
+
+int Expression_Tree_Event_Handler::get_handle() const
+{
+    return handle;
+}
+
+void Expression_Tree_Event_Handler::handle_open()
+{
+    // a batch gets nothing but its results
+    if (!framed)
+        prompt_user();
+    flush_output();
 }
 
 void Expression_Tree_Event_Handler::handle_input()
 {
-    prompt_user();
+    // a connection that doesn't read its output gets no more input
+    // until it does
+    if (output_buffer.size() > 0)
+        return;
+
+    if (!(framed ? handle_batches() : handle_lines()))
+        return;
+
+    if (flush_output() && done && !console)
+        close_connection();
+}
+
+bool Expression_Tree_Event_Handler::handle_lines()
+{
     std::string input;
-    if (!get_input(input))
-        Reactor::instance()->end_event_loop();
+    while (!done && get_input(input)) {
+        handle_command(input);
+        if (!done)
+            prompt_user();
+        if (output_buffer.size() >= FLUSH_SIZE && !flush_output())
+            return false;
+    }
 
+    // like std::getline(), the end of input reads as an empty command
+    if (closed && !done) {
+        finish();
+        handle_command(input);
+    }
+    return true;
+}
+
+bool Expression_Tree_Event_Handler::handle_batches()
+{
+    try {
+        const char* body;
+        std::size_t length;
+        while (!done && get_frame(body, length)) {
+            handle_batch(body, length);
+            if (output_buffer.size() >= FLUSH_SIZE && !flush_output())
+                return false;
+        }
+    } catch (std::domain_error&) {
+        // there's no telling where the next frame starts
+        finish();
+    }
+
+    // a frame cut short by the end of input is dropped
+    if (closed)
+        finish();
+    return true;
+}
+
+void Expression_Tree_Event_Handler::handle_batch(const char* body, std::size_t length)
+{
+    // check the framing first, so a bad batch runs no commands
+    std::size_t offset = 0;
+    while (offset < length) {
+        if (length - offset < LENGTH_SIZE
+            || get_length(body + offset) > length - offset - LENGTH_SIZE)
+            throw std::domain_error("Bad command length");
+        offset += LENGTH_SIZE + get_length(body + offset);
+    }
+
+    // the lengths of the frame and of each result are filled in once
+    // they're written
+    static const char placeholder[LENGTH_SIZE] = {};
+    std::size_t frame = output_buffer.size();
+    output.write(placeholder, LENGTH_SIZE);
+
+    std::string command;
+    for (offset = 0; offset < length && !done;) {
+        std::size_t size = get_length(body + offset);
+        command.assign(body + offset + LENGTH_SIZE, size);
+        offset += LENGTH_SIZE + size;
+
+        std::size_t result = output_buffer.size();
+        output.write(placeholder, LENGTH_SIZE);
+        handle_command(command);
+        put_length(output_buffer, result, output_buffer.size() - result - LENGTH_SIZE);
+    }
+    put_length(output_buffer, frame, output_buffer.size() - frame - LENGTH_SIZE);
+}
+
+void Expression_Tree_Event_Handler::handle_output()
+{
+    if (output_buffer.size() > 0 && flush_output())
+        handle_input();
+}
+
+void Expression_Tree_Event_Handler::handle_timeout(long)
+{
+    Reactor::instance()->remove_input_handler(this);
+}
+
+void Expression_Tree_Event_Handler::close_connection()
+{
+    if (!lingering) {
+        shutdown(handle, SHUT_WR);
+        Reactor::instance()->schedule_timer(this, LINGER_TIME);
+        lingering = true;
+    }
+
+    std::string input;
+    while (get_input(input))
+        continue;
+    if (closed)
+        Reactor::instance()->remove_input_handler(this);
+}
+
+bool Expression_Tree_Event_Handler::flush_output()
+{
+    // standard output is flushed once per input that arrives, not
+    // per command
+    output.flush();
+
+    while (output_buffer.size() > 0) {
+        ssize_t count = send(handle, output_buffer.data(), output_buffer.size(), MSG_NOSIGNAL);
+        if (count > 0) {
+            output_buffer.consume(count);
+        } else if (count < 0 && errno == EAGAIN) {
+            return false;
+        } else if (count < 0 && errno != EINTR) {
+            // the peer is gone, so its output is dropped
+            output_buffer.consume(output_buffer.size());
+            finish();
+        }
+    }
+    return true;
+}
+
+void Expression_Tree_Event_Handler::handle_command(const std::string& input)
+{
     Expression_Tree_Command command = make_command(input);
     try {
         std::string lowerInput = input;
@@ -37,35 +219,93 @@ void Expression_Tree_Event_Handler::handle_input()
 
         if (!execute_command(command)) {
             if (lowerInput == "quit") {
-                Reactor::instance()->end_event_loop();
+                finish();
             } else {
-                std::cout << "Enter a valid command" << std::endl;
+                output << "Enter a valid command" << std::endl;
                 tree_context.state()->print_valid_commands(tree_context);
             }
         } else {
             if (lowerInput != "history") {
-                tree_context.addToCommands(lowerInput);
+                tree_context.addToCommands(std::move(lowerInput));
             }
             last_valid_command = command;
             if (Options::instance()->verbose())
                 tree_context.state()->print_valid_commands(tree_context);
         }
     } catch (Expression_Tree::Invalid_Iterator& e) {
-        std::cout << "\nERROR: Bad traversal type (" << e.what() << ")\n";
+        output << "\nERROR: Bad traversal type (" << e.what() << ")\n";
         tree_context.state()->print_valid_commands(tree_context);
     } catch (Expression_Tree_State::Invalid_State& e) {
-        std::cout << "\nERROR: " << e.what() << std::endl;
+        output << "\nERROR: " << e.what() << std::endl;
         tree_context.state()->print_valid_commands(tree_context);
     } catch (std::domain_error& e) {
-        std::cout << "\nERROR: " << e.what() << std::endl;
+        output << "\nERROR: " << e.what() << std::endl;
         tree_context.state()->print_valid_commands(tree_context);
     }
 }
 
+void Expression_Tree_Event_Handler::finish()
+{
+    done = true;
+    if (console)
+        Reactor::instance()->end_event_loop();
+}
+
 bool Expression_Tree_Event_Handler::get_input(std::string& input)
 {
-    std::getline(std::cin, input);
-    return !std::cin.fail();
+    input.clear();
+    for (;;) {
+        std::string::size_type newline = buffer.find('\n', start);
+        if (newline != std::string::npos) {
+            input.assign(buffer, start, newline - start);
+            start = newline + 1;
+            return true;
+        }
+        if (closed) {
+            // the last line may not end with a newline
+            input.assign(buffer, start, std::string::npos);
+            start = buffer.size();
+            return !input.empty();
+        }
+        if (!read_input(READ_SIZE))
+            return false;
+    }
+}
+
+bool Expression_Tree_Event_Handler::get_frame(const char*& body, std::size_t& length)
+{
+    for (;;) {
+        std::size_t wanted = LENGTH_SIZE;
+        if (buffer.size() - start >= LENGTH_SIZE) {
+            length = get_length(&buffer[start]);
+            if (length > MAX_FRAME_SIZE)
+                throw std::domain_error("Frame too large");
+            if (buffer.size() - start >= LENGTH_SIZE + length) {
+                body = &buffer[start + LENGTH_SIZE];
+                start += LENGTH_SIZE + length;
+                return true;
+            }
+            wanted += length;
+        }
+        if (closed || !read_input(wanted - (buffer.size() - start)))
+            return false;
+    }
+}
+
+bool Expression_Tree_Event_Handler::read_input(std::string::size_type wanted)
+{
+    // keep what hasn't been handled and read after it
+    buffer.erase(0, start);
+    start = 0;
+    std::string::size_type used = buffer.size();
+    std::string::size_type size = std::max(READ_SIZE, std::min(wanted, MAX_READ_SIZE));
+    buffer.resize(used + size);
+    ssize_t count = read(handle, &buffer[used], size);
+    buffer.resize(used + std::max<ssize_t>(count, 0));
+
+    if (count == 0 || (count < 0 && errno != EINTR && errno != EAGAIN))
+        closed = true;
+    return !(count < 0 && errno == EAGAIN);
 }
 
 bool Expression_Tree_Event_Handler::execute_command(Expression_Tree_Command& command)
@@ -73,15 +313,42 @@ bool Expression_Tree_Event_Handler::execute_command(Expression_Tree_Command& com
     return command.execute();
 }
 
-Expression_Tree_Event_Handler::Expression_Tree_Event_Handler()
-    : tree_context()
+Expression_Tree_Event_Handler::Expression_Tree_Event_Handler(int handle, bool framed)
+    : output(handle == STDIN_FILENO ? std::cout.rdbuf() : &output_buffer)
+    , tree_context(output)
     , command_factory(tree_context)
     , last_valid_command(new Null_Command(tree_context))
+    , handle(handle)
+    , console(handle == STDIN_FILENO)
+    , owns_handle(!console)
+    , framed(framed && !console)
+    , start(0)
+    , closed(false)
+    , done(false)
+    , lingering(false)
+{
+    // a terminal shares its open file with standard output, which has
+    // to stay blocking, so read it through an open file of our own
+    const char* name = console && isatty(handle) ? ttyname(handle) : nullptr;
+    if (name) {
+        int terminal = open(name, O_RDONLY | O_CLOEXEC);
+        if (terminal >= 0) {
+            handle = terminal;
+            owns_handle = true;
+        }
+    }
+}
+
+Expression_Tree_Event_Handler::~Expression_Tree_Event_Handler()
 {
+    if (owns_handle)
+        close(handle);
 }
 
-Verbose_Expression_Tree_Event_Handler::Verbose_Expression_Tree_Event_Handler()
-    : prompted(false)
+Verbose_Expression_Tree_Event_Handler::Verbose_Expression_Tree_Event_Handler(
+    int handle, bool framed)
+    : Expression_Tree_Event_Handler(handle, framed)
+    , prompted(false)
 {
 }
 
@@ -91,8 +358,8 @@ void Verbose_Expression_Tree_Event_Handler::prompt_user()
         tree_context.state()->print_valid_commands(tree_context);
         prompted = true;
     }
-    std::cout << "> ";
-    std::cout.flush();
+    output << "> ";
+    output.flush();
 }
 
 Expression_Tree_Command Verbose_Expression_Tree_Event_Handler::make_command(
@@ -101,10 +368,23 @@ Expression_Tree_Command Verbose_Expression_Tree_Event_Handler::make_command(
     return command_factory.make_command(input);
 }
 
+Macro_Command_Expression_Tree_Event_Handler::Macro_Command_Expression_Tree_Event_Handler(
+    int handle, bool framed)
+    : Expression_Tree_Event_Handler(handle, framed)
+{
+}
+
 void Macro_Command_Expression_Tree_Event_Handler::prompt_user()
 {
-    std::cout << "> ";
-    std::cout.flush();
+    output << "> ";
+}
+
+void Macro_Command_Expression_Tree_Event_Handler::handle_command(const std::string& input)
+{
+    if (input.empty())
+        Expression_Tree_Event_Handler::handle_command(input);
+    else
+        tree_context.evaluate_expression(input);
 }
 
 Expression_Tree_Command Macro_Command_Expression_Tree_Event_Handler::make_command(
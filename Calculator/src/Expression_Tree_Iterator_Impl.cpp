@@ -52,7 +52,7 @@ void In_Order_Expression_Tree_Iterator_Impl::operator++()
     // we know that at this point there is no left () of top ()
     // because we would have already visited it.
 
-    if (!stack.empty()) {
+    if (!stack.is_empty()) {
         // if we have nodes greater than ourselves
         if (!stack.top().right().is_null()) {
             // push the right child node onto the stack
@@ -92,7 +92,7 @@ bool In_Order_Expression_Tree_Iterator_Impl::operator==(
 
         if (t1.get_root() == t2.get_root() && stack.size() == in_order_rhs->stack.size()) {
             // Check for both being is_empty (special condition).
-            if (stack.empty() && in_order_rhs->stack.empty())
+            if (stack.is_empty() && in_order_rhs->stack.is_empty())
                 return true;
 
             // check the front's node pointer. If the node pointers are
@@ -156,7 +156,7 @@ void Pre_Order_Expression_Tree_Iterator_Impl::operator++()
     // we know that at this point there is no left () of top ()
     // because we would have already visited it.
 
-    if (!stack.empty()) {
+    if (!stack.is_empty()) {
         // we need to pop the node off the stack before pushing the
         // children, or else we'll revisit this node later
 
@@ -196,7 +196,7 @@ bool Pre_Order_Expression_Tree_Iterator_Impl::operator==(
 
         if (t1.get_root() == t2.get_root() && stack.size() == pre_order_rhs->stack.size()) {
             // check for both being is_empty (special condition)
-            if (stack.empty() && pre_order_rhs->stack.empty())
+            if (stack.is_empty() && pre_order_rhs->stack.is_empty())
                 return true;
 
             // check the front's node pointer. If the node pointers
@@ -240,76 +240,51 @@ Post_Order_Expression_Tree_Iterator_Impl::Post_Order_Expression_Tree_Iterator_Im
     // if the caller doesn't want an end iterator, insert the root tree
     // into the queue.
     if (!end_iter && !tree.is_null()) {
-        Expression_Tree current = const_cast<Expression_Tree&>(tree);
-        stack.push(current);
-
-        // the commented code does not work on unary operator nodes with no left
-        // child, but
-        // a right child - or at least, there is a certain depth that this will not
-        // go down
-
-        while (!current.is_null()) {
-            if (!current.right().is_null())
-                stack.push(current.right());
-            if (!current.left().is_null()) {
-                // if there was a left, then update current
-                // this is the case for all non-negations
-                stack.push(current.left());
-                current = current.left();
-            } else
-                // if there was not a left, then current = current->right_
-                // this handles cases of unary nodes, like negations
-                current = current.right();
-        }
+        stack.push(std::make_pair(const_cast<Expression_Tree&>(tree), false));
+        descend();
+    }
+}
+
+// push children until the top of the stack is ready to be visited
+void Post_Order_Expression_Tree_Iterator_Impl::descend()
+{
+    while (!stack.top().second) {
+        stack.top().second = true;
+        Expression_Tree current = stack.top().first;
+
+        // the right child is pushed first so the left one is visited
+        // first. Unary nodes (eg negation) only have a right child and
+        // factorial only has a left one.
+        if (!current.right().is_null())
+            stack.push(std::make_pair(current.right(), false));
+        if (!current.left().is_null())
+            stack.push(std::make_pair(current.left(), false));
     }
 }
 
 // Returns the Node that the iterator is pointing to (non-const version)
 Expression_Tree Post_Order_Expression_Tree_Iterator_Impl::operator*()
 {
-    return stack.top();
+    return stack.top().first;
 }
 
 // Returns the Node that the iterator is pointing to (const version)
 const Expression_Tree Post_Order_Expression_Tree_Iterator_Impl::operator*() const
 {
-    return stack.top();
+    return stack.top().first;
 }
 
 // moves the iterator to the next node (pre-increment)
 void Post_Order_Expression_Tree_Iterator_Impl::operator++()
 {
-    // we know that at this point there is no left () of top ()
-    // because we would have already visited it.
-
-    if (!stack.empty()) {
-        // we need to pop the node off the stack before pushing the
-        // children, or else we'll revisit this node later
-
-        Expression_Tree current = stack.top();
+    if (!stack.is_empty()) {
         stack.pop();
 
-        // This is where stuff gets a little confusing.
-
-        if (!stack.empty() && stack.top().left().get_root() != current.get_root()
-            && stack.top().right().get_root() != current.get_root()) {
-            current = stack.top();
-
-            while (!current.is_null()) {
-                if (!current.right().is_null())
-                    stack.push(current.right());
-                if (!current.left().is_null()) {
-                    // if there was a left, then update current
-                    // this is the case for all non-negations
-                    stack.push(current.left());
-                    current = current.left();
-                } else {
-                    // if there was not a left, then current = current->right_
-                    // this handles cases of unary nodes, like negations
-                    current = current.right();
-                }
-            }
-        }
+        // the new top is either the parent, whose children are now all
+        // visited, or a right sibling that still has to be descended
+        // into
+        if (!stack.is_empty())
+            descend();
     }
 }
 
@@ -336,14 +311,14 @@ bool Post_Order_Expression_Tree_Iterator_Impl::operator==(
 
         if (t1.get_root() == t2.get_root() && stack.size() == post_order_rhs->stack.size()) {
             // check for both being is_empty (special condition)
-            if (stack.empty() && post_order_rhs->stack.empty())
+            if (stack.is_empty() && post_order_rhs->stack.is_empty())
                 return true;
 
             // check the front's node pointer. If the node pointers are
             // equal, then both iterators are pointing to the same
             // position in the tree.
 
-            if (stack.top() == post_order_rhs->stack.top())
+            if (stack.top().first == post_order_rhs->stack.top().first)
                 return true;
         }
     }
@@ -0,0 +1,173 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#include "Expression_Tree_Server.h"
+#include "Connection_Queue.h"
+#include "Expression_Tree_Event_Handler.h"
+#include "Options.h"
+#include "Reactor.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Throw the error of the last system call that failed.
+static void fail(const std::string& what)
+{
+    throw std::domain_error(what + ": " + std::strerror(errno));
+}
+
+Expression_Tree_Server::Expression_Tree_Server(const std::string& address)
+    : handle(-1)
+    , tcp(false)
+    , address(address)
+    , turn(0)
+{
+    // a port, or a host and a port, is TCP and anything else is a path
+    std::string::size_type colon = address.rfind(':');
+    std::string port = address.substr(colon == std::string::npos ? 0 : colon + 1);
+    tcp = !port.empty() && port.find_first_not_of("0123456789") == std::string::npos
+        && address.find('/') == std::string::npos;
+
+    sockaddr_storage storage {};
+    socklen_t length;
+    if (tcp) {
+        std::string host = colon == std::string::npos ? "127.0.0.1" : address.substr(0, colon);
+        if (host == "localhost")
+            host = "127.0.0.1";
+        auto ip = reinterpret_cast<sockaddr_in*>(&storage);
+        ip->sin_family = AF_INET;
+        if (port.size() > 5 || std::stoul(port) > 65535
+            || inet_pton(AF_INET, host.c_str(), &ip->sin_addr) != 1)
+            throw std::domain_error("Bad address " + address);
+        // sessions can't be authenticated, so they're only served to
+        // this machine
+        if ((ntohl(ip->sin_addr.s_addr) >> 24) != 127)
+            throw std::domain_error("Not a loopback address " + address);
+        ip->sin_port = htons(static_cast<std::uint16_t>(std::stoul(port)));
+        length = sizeof(sockaddr_in);
+    } else {
+        auto local = reinterpret_cast<sockaddr_un*>(&storage);
+        local->sun_family = AF_UNIX;
+        if (address.size() >= sizeof(local->sun_path))
+            throw std::domain_error("Socket path is too long");
+        std::strcpy(local->sun_path, address.c_str());
+        length = sizeof(sockaddr_un);
+
+        // a socket left behind by an earlier server is replaced
+        struct stat status;
+        if (lstat(address.c_str(), &status) == 0 && S_ISSOCK(status.st_mode))
+            unlink(address.c_str());
+    }
+
+    handle = socket(storage.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (handle < 0)
+        fail("Can't make a socket");
+
+    // servers on other event loops listen on the same port, and the
+    // kernel spreads the connections over them
+    int on = 1;
+    if (tcp) {
+        setsockopt(handle, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        setsockopt(handle, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on));
+    }
+    if (bind(handle, reinterpret_cast<sockaddr*>(&storage), length) < 0
+        || listen(handle, SOMAXCONN) < 0) {
+        int error = errno;
+        close(handle);
+        errno = error;
+        fail("Can't listen on " + address);
+    }
+
+    if (tcp) {
+        // the clones need the port that was picked for port 0
+        auto ip = reinterpret_cast<sockaddr_in*>(&storage);
+        getsockname(handle, reinterpret_cast<sockaddr*>(&storage), &length);
+        char host[INET_ADDRSTRLEN];
+        inet_ntop(AF_INET, &ip->sin_addr, host, sizeof(host));
+        this->address = std::string(host) + ":" + std::to_string(ntohs(ip->sin_port));
+    } else {
+        path = address;
+    }
+}
+
+Expression_Tree_Server* Expression_Tree_Server::clone() const
+{
+    if (!tcp)
+        throw std::domain_error("Can't share the Unix socket " + address);
+    return new Expression_Tree_Server(address);
+}
+
+bool Expression_Tree_Server::reuses_port() const
+{
+    return tcp;
+}
+
+void Expression_Tree_Server::hand_off(const std::vector<Connection_Queue*>& queues)
+{
+    this->queues = queues;
+    turn = 0;
+}
+
+Expression_Tree_Server::~Expression_Tree_Server()
+{
+    close(handle);
+    if (!path.empty())
+        unlink(path.c_str());
+}
+
+int Expression_Tree_Server::get_handle() const
+{
+    return handle;
+}
+
+void Expression_Tree_Server::handle_input()
+{
+    for (;;) {
+        int connection = accept4(handle, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (connection < 0) {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            if (errno == EMFILE || errno == ENFILE)
+                std::cerr << "ERROR: Can't accept a connection: " << std::strerror(errno)
+                          << std::endl;
+            return;
+        }
+
+        // results go back as soon as they're written
+        int on = 1;
+        if (tcp)
+            setsockopt(connection, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+        std::size_t next = turn;
+        turn = (turn + 1) % (queues.size() + 1);
+        if (next == 0 || !queues[next - 1]->hand_off(connection))
+            serve(connection);
+    }
+}
+
+void Expression_Tree_Server::serve(int connection)
+{
+    Event_Handler* session = Expression_Tree_Event_Handler::make_handler(
+        Options::instance()->verbose(), connection, Options::instance()->framed());
+    try {
+        Reactor::instance()->register_input_handler(session);
+    } catch (std::domain_error& e) {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        delete session;
+    }
+}
@@ -1,10 +1,18 @@
+#include "Bytecode.h"
 #include "Evaluation_Visitor.h"
+#include "Flat_Tree.h"
+#include "Native_Code.h"
 #include "Expression_Tree_Context.h"
-#include "Expression_Tree_Iterator.h"
+#include "Optimization_Visitor.h"
+#include "Options.h"
+#include "Parallel_Evaluator.h"
 #include "Print_Visitor.h"
-#include <algorithm>
+#include "Tree_Traversal.h"
 #include <iostream>
 #include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 // Author: Yumeng Jiang
 // VUnetid: jiany18
@@ -14,52 +22,104 @@
 // Honor statement: I have neither given nor received any unauthorized aid on this assignment.
 // Assignment Number: Project #7
 
-/**
- * @class Accept_Visitor_Adapter
- * @brief This functor implements the Adapter pattern so the @a
- *        Component_Node's accept() method can be called with the
- *        appropriate visitor in the context of the std:for_each()
- *        algorithm.
- */
-template <typename VISITOR> class Accept_Visitor_Adapter {
-public:
-    // Constructor.
-    explicit Accept_Visitor_Adapter(VISITOR& v)
-        : visitor(v)
-    {
-    }
-
-    // Accept the visitor_ to visit the node.
-    void operator()(const Expression_Tree& t)
-    {
-        t.accept(visitor);
-    }
-
-private:
-    VISITOR& visitor;
-};
-
 // this method traverses the tree in with a given traversal strategy
 void Expression_Tree_State::print_tree(
     const Expression_Tree& tree, const std::string& traversal_order, std::ostream& os)
 {
     os << "traverse tree using strategy '" << traversal_order << "':" << std::endl;
 
+    if (Options::instance()->flat() && !tree.is_null()) {
+        tree.flat().print(traversal_order, os);
+        os << std::endl;
+        return;
+    }
+
     // create a print visitor
-    Print_Visitor print_visitor;
-    std::for_each(tree.begin(traversal_order), tree.end(traversal_order),
-        Accept_Visitor_Adapter<Print_Visitor>(print_visitor));
+    Print_Visitor print_visitor(os);
+    Tree_Traversal traversal(tree.get_root(), Tree_Traversal::order(traversal_order),
+        Options::instance()->threaded());
+    while (const Component_Node* node = traversal.next())
+        node->accept(print_visitor);
 
     os << std::endl;
 }
 
-void Expression_Tree_State::evaluate_tree(
-    const Expression_Tree& tree, const std::string& traversal_order, std::ostream&)
+void Expression_Tree_State::evaluate_tree(Expression_Tree_Context& context,
+    const Expression_Tree& tree, const std::string& traversal_order)
 {
-    Evaluation_Visitor evaluation_visitor;
-    std::for_each(tree.begin(traversal_order), tree.end(traversal_order),
-        Accept_Visitor_Adapter<Evaluation_Visitor>(evaluation_visitor));
-    std::cout << evaluation_visitor.total() << std::endl;
+    std::ostream& os = context.out();
+    if (traversal_order == "post-order" && !tree.is_null()) {
+        int result;
+        bool evaluated;
+        // a shared node would be evaluated once per parent, so only
+        // trees are split
+        if (Options::instance()->fork_join() && !Options::instance()->share_subtrees()
+            && tree.get_root()->size() >= Parallel_Evaluator::default_threshold) {
+            Parallel_Evaluator evaluator(context.fork_join_pool());
+            evaluated = evaluator.evaluate(tree.get_root(), result);
+        } else if (Options::instance()->flat()) {
+            evaluated = tree.flat().evaluate(result);
+        } else if (Options::instance()->jit() && tree.native_code().valid()) {
+            evaluated = tree.native_code().evaluate(result);
+        } else {
+            evaluated = tree.bytecode().evaluate(result);
+        }
+        // results aren't flushed one by one, the output is flushed
+        // once the input that has arrived is handled
+        if (evaluated) {
+            os << result << '\n';
+            return;
+        }
+
+        // division or modulus by zero, let the visitor report it.  A
+        // DAG would be expanded back into a tree by a traversal, so
+        // walk it directly instead.
+        if (Options::instance()->share_subtrees()) {
+            os << evaluate_shared_tree(tree.get_root(), os) << '\n';
+            return;
+        }
+    }
+
+    Evaluation_Visitor evaluation_visitor(os);
+    Tree_Traversal traversal(tree.get_root(), Tree_Traversal::order(traversal_order),
+        Options::instance()->threaded());
+    while (const Component_Node* node = traversal.next())
+        node->accept(evaluation_visitor);
+    os << evaluation_visitor.total() << '\n';
+}
+
+int Expression_Tree_State::evaluate_shared_tree(const Component_Node* root, std::ostream& os)
+{
+    Evaluation_Visitor evaluation_visitor(os);
+    // value of every distinct node evaluated so far
+    std::unordered_map<const Component_Node*, int> values;
+    // post-order walk; the flag is true once the node's children are
+    // on the stack ahead of it
+    std::vector<std::pair<const Component_Node*, bool>> pending { { root, false } };
+
+    while (!pending.empty()) {
+        auto [node, expanded] = pending.back();
+        pending.pop_back();
+
+        auto iter = values.find(node);
+        if (iter != values.end()) {
+            evaluation_visitor.push(iter->second);
+        } else if (!expanded) {
+            pending.emplace_back(node, true);
+            if (node->right())
+                pending.emplace_back(node->right(), false);
+            if (node->left())
+                pending.emplace_back(node->left(), false);
+        } else {
+            node->accept(evaluation_visitor);
+            // nothing is remembered after a division by zero emptied
+            // the stack, so a shared node reports it again
+            if (evaluation_visitor.size() > 0)
+                values.emplace(node, evaluation_visitor.total());
+        }
+    }
+
+    return evaluation_visitor.total();
 }
 
 // Static data member definitions.
@@ -142,13 +202,13 @@ void Uninitialized_State::evaluate(Expression_Tree_Context&, const std::string&)
 
 void Uninitialized_State::print_valid_commands(Expression_Tree_Context& context) const
 {
-    std::cout << "1a. format [in-order]\n";
-    std::cout << "1b. set [variable=value]\n";
-    std::cout << "2. expr [expression]\n";
-    std::cout << "3a. eval [post-order]\n";
-    std::cout << "3b. print [in-order | pre-order | post-order | level-order]\n";
-    std::cout << "0. quit\n";
-    std::cout.flush();
+    context.out() << "1a. format [in-order]\n";
+    context.out() << "1b. set [variable=value]\n";
+    context.out() << "2. expr [expression]\n";
+    context.out() << "3a. eval [post-order]\n";
+    context.out() << "3b. print [in-order | pre-order | post-order | level-order]\n";
+    context.out() << "0. quit\n";
+    context.out().flush();
 }
 
 void Uninitialized_State::set(Expression_Tree_Context& context, const std::string& key_value_pair)
@@ -165,13 +225,13 @@ void Pre_Order_Uninitialized_State::make_tree(Expression_Tree_Context&, const st
 
 void Pre_Order_Initialized_State::print(Expression_Tree_Context& context, const std::string& format)
 {
-    Expression_Tree_State::print_tree(context.tree(), format, std::cout);
+    Expression_Tree_State::print_tree(context.tree(), format, context.out());
 }
 
 void Pre_Order_Initialized_State::evaluate(
     Expression_Tree_Context& context, const std::string& param)
 {
-    Expression_Tree_State::evaluate_tree(context.tree(), param, std::cout);
+    Expression_Tree_State::evaluate_tree(context, context.tree(), param);
 }
 
 void Post_Order_Uninitialized_State::make_tree(
@@ -184,12 +244,12 @@ void Post_Order_Uninitialized_State::make_tree(
 void Post_Order_Initialized_State::print(
     Expression_Tree_Context& context, const std::string& format)
 {
-    Expression_Tree_State::print_tree(context.tree(), format, std::cout);
+    Expression_Tree_State::print_tree(context.tree(), format, context.out());
 }
 
 void Post_Order_Initialized_State::evaluate(Expression_Tree_Context& context, const std::string&)
 {
-    Expression_Tree_State::evaluate_tree(context.tree(), "param", std::cout);
+    Expression_Tree_State::evaluate_tree(context, context.tree(), "param");
 }
 
 void Level_Order_Uninitialized_State::make_tree(Expression_Tree_Context&, const std::string&)
@@ -201,39 +261,62 @@ void Level_Order_Uninitialized_State::make_tree(Expression_Tree_Context&, const
 void Level_Order_Initialized_State::print(
     Expression_Tree_Context& context, const std::string& format)
 {
-    Expression_Tree_State::print_tree(context.tree(), format, std::cout);
+    Expression_Tree_State::print_tree(context.tree(), format, context.out());
 }
 
 void Level_Order_Initialized_State::evaluate(
     Expression_Tree_Context& context, const std::string& param)
 {
-    Expression_Tree_State::evaluate_tree(context.tree(), param, std::cout);
+    Expression_Tree_State::evaluate_tree(context, context.tree(), param);
 }
 
 void In_Order_Uninitialized_State::make_tree(
     Expression_Tree_Context& tree_context, const std::string& expr)
 {
-    // Interpreter_Context context;
-    Interpreter interpreter;
-    tree_context.tree(interpreter.interpret(tree_context.int_context, expr));
+    build_tree(tree_context, expr);
     tree_context.state(new In_Order_Initialized_State);
 }
 
+const Expression_Tree& In_Order_Uninitialized_State::build_tree(
+    Expression_Tree_Context& tree_context, const std::string& expr)
+{
+    // reuse the tree if this expression was built recently
+    std::string& key = tree_context.cache_key;
+    Expression_Tree_Cache::normalize(expr, key);
+    const Expression_Tree* cached = tree_context.cache.find(key);
+    if (!cached) {
+        Expression_Tree tree = tree_context.interpreter.interpret(tree_context.int_context, expr);
+        if (Options::instance()->optimize()) {
+            Optimization_Visitor optimizer(Options::instance()->share_subtrees());
+            tree = optimizer.optimize(tree);
+        }
+        // failed parses aren't cached, so their errors are reported again
+        if (!tree.is_null())
+            cached = tree_context.cache.insert(key, tree);
+        if (!cached) {
+            tree_context.tree(tree);
+            return tree_context.tree();
+        }
+    }
+    tree_context.tree(*cached);
+    return *cached;
+}
+
 void In_Order_Uninitialized_State::print_valid_commands(Expression_Tree_Context& context) const
 {
-    std::cout << "\n";
-    std::cout << "1. expr [expression]\n";
-    std::cout << "2a. eval [post-order]\n";
-    std::cout << "2b. print [in-order | pre-order | post-order | level-order]\n";
-    std::cout << "0a. format [in-order]\n";
-    std::cout << "0b. set [variable=value]\n";
+    context.out() << "\n";
+    context.out() << "1. expr [expression]\n";
+    context.out() << "2a. eval [post-order]\n";
+    context.out() << "2b. print [in-order | pre-order | post-order | level-order]\n";
+    context.out() << "0a. format [in-order]\n";
+    context.out() << "0b. set [variable=value]\n";
     if (context.hasSet()) {
-        std::cout << "0b-1. get [variable]\n";
-        std::cout << "0b-2. list\n";
+        context.out() << "0b-1. get [variable]\n";
+        context.out() << "0b-2. list\n";
     }
-    std::cout << "0c. history\n";
-    std::cout << "0d. quit\n";
-    std::cout.flush();
+    context.out() << "0c. history\n";
+    context.out() << "0d. quit\n";
+    context.out().flush();
 }
 
 void In_Order_Uninitialized_State::set(
@@ -245,29 +328,29 @@ void In_Order_Uninitialized_State::set(
 
 void In_Order_Initialized_State::print(Expression_Tree_Context& context, const std::string& format)
 {
-    print_tree(context.tree(), format, std::cout);
+    print_tree(context.tree(), format, context.out());
 }
 
 void In_Order_Initialized_State::evaluate(
     Expression_Tree_Context& context, const std::string& param)
 {
-    Expression_Tree_State::evaluate_tree(context.tree(), param, std::cout);
+    Expression_Tree_State::evaluate_tree(context, context.tree(), param);
 }
 
 void In_Order_Initialized_State::print_valid_commands(Expression_Tree_Context& context) const
 {
-    std::cout << "\n";
-    std::cout << "1a. eval [post-order]\n";
-    std::cout << "1b. print [in-order | pre-order | post-order | level-order]\n";
-    std::cout << "0a. format [in-order]\n";
-    std::cout << "0b. set [variable=value]\n";
+    context.out() << "\n";
+    context.out() << "1a. eval [post-order]\n";
+    context.out() << "1b. print [in-order | pre-order | post-order | level-order]\n";
+    context.out() << "0a. format [in-order]\n";
+    context.out() << "0b. set [variable=value]\n";
     if (context.hasSet()) {
-        std::cout << "0b-1. get [variable]\n";
-        std::cout << "0b-2. list\n";
+        context.out() << "0b-1. get [variable]\n";
+        context.out() << "0b-2. list\n";
     }
-    std::cout << "0c. history\n";
-    std::cout << "0d. quit\n";
-    std::cout.flush();
+    context.out() << "0c. history\n";
+    context.out() << "0d. quit\n";
+    context.out().flush();
 }
 
 void In_Order_Initialized_State::set(
@@ -0,0 +1,354 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#include "Flat_Tree.h"
+#include "AStack.h"
+#include "Component_Node.h"
+#include "Expression_Tree.h"
+#include "Flat_Visitor.h"
+#include "Interpreter.h"
+#include "LQueue.h"
+#include "Leaf_Node.h"
+#include "Variable_Node.h"
+#include "Visitor.h"
+#include <cstring>
+#include <math.h>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @class Flat_Tree_Builder
+ * @brief Visitor that records the kind and value of each node it visits.
+ */
+class Flat_Tree_Builder : public Visitor {
+public:
+    explicit Flat_Tree_Builder(Flat_Tree& tree)
+        : tree(tree)
+        , kind(Flat_Tree::NUMBER)
+        , value(0)
+    {
+    }
+
+    void visit(const Leaf_Node& node) override
+    {
+        set(Flat_Tree::NUMBER, node.item());
+    }
+
+    void visit(const Variable_Node& node) override
+    {
+        tree.context = &node.context();
+        set(Flat_Tree::VARIABLE, node.slot());
+    }
+
+    void visit(const Composite_Negate_Node&) override
+    {
+        set(Flat_Tree::NEGATE, 0);
+    }
+
+    void visit(const Composite_Factorial_Node&) override
+    {
+        set(Flat_Tree::FACTORIAL, 0);
+    }
+
+    void visit(const Composite_Add_Node&) override
+    {
+        set(Flat_Tree::ADD, 0);
+    }
+
+    void visit(const Composite_Subtract_Node&) override
+    {
+        set(Flat_Tree::SUBTRACT, 0);
+    }
+
+    void visit(const Composite_Multiply_Node&) override
+    {
+        set(Flat_Tree::MULTIPLY, 0);
+    }
+
+    void visit(const Composite_Divide_Node&) override
+    {
+        set(Flat_Tree::DIVIDE, 0);
+    }
+
+    void visit(const Composite_Modulus_Node&) override
+    {
+        set(Flat_Tree::MODULUS, 0);
+    }
+
+    void visit(const Composite_Power_Node&) override
+    {
+        set(Flat_Tree::POWER, 0);
+    }
+
+    Flat_Tree& tree;
+    // Kind and value of the node visited last.
+    Flat_Tree::Kind kind;
+    int value;
+
+private:
+    void set(Flat_Tree::Kind new_kind, int new_value)
+    {
+        kind = new_kind;
+        value = new_value;
+    }
+};
+
+/**
+ * @class Flat_Print_Visitor
+ * @brief Prints flat nodes the same way Print_Visitor prints nodes.
+ */
+class Flat_Print_Visitor : public Flat_Visitor {
+public:
+    explicit Flat_Print_Visitor(std::ostream& out)
+        : out(out)
+    {
+    }
+
+    void visit(const Flat_Tree& tree, std::uint32_t node) override
+    {
+        switch (tree.kind(node)) {
+        case Flat_Tree::NUMBER:
+        case Flat_Tree::VARIABLE:
+            out << " " << tree.item(node);
+            break;
+        case Flat_Tree::NEGATE:
+            out << '-';
+            break;
+        case Flat_Tree::FACTORIAL:
+            out << "!";
+            break;
+        case Flat_Tree::ADD:
+            out << " +";
+            break;
+        case Flat_Tree::SUBTRACT:
+            out << " -";
+            break;
+        case Flat_Tree::MULTIPLY:
+            out << " *";
+            break;
+        case Flat_Tree::DIVIDE:
+            out << " /";
+            break;
+        case Flat_Tree::MODULUS:
+            out << " %";
+            break;
+        case Flat_Tree::POWER:
+            out << "^";
+            break;
+        }
+    }
+
+private:
+    std::ostream& out;
+};
+
+// Flatten in post-order, so children get their indices before their
+// parents.  A node that was already flattened keeps its first index.
+Flat_Tree::Flat_Tree(const Component_Node* root)
+    : count(0)
+    , values(nullptr)
+    , lefts(nullptr)
+    , rights(nullptr)
+    , kinds(nullptr)
+    , context(nullptr)
+{
+    std::vector<int> node_values;
+    std::vector<std::uint32_t> node_lefts;
+    std::vector<std::uint32_t> node_rights;
+    std::vector<Kind> node_kinds;
+
+    Flat_Tree_Builder builder(*this);
+    std::unordered_map<const Component_Node*, std::uint32_t> index;
+    // the flag is true once the node's children are on the stack ahead
+    // of it
+    std::vector<std::pair<const Component_Node*, bool>> pending { { root, false } };
+
+    auto index_of = [&index](const Component_Node* node) {
+        return node ? index.find(node)->second : none;
+    };
+
+    while (!pending.empty()) {
+        auto [node, expanded] = pending.back();
+        pending.pop_back();
+
+        if (index.count(node))
+            continue;
+        if (!expanded) {
+            pending.emplace_back(node, true);
+            if (node->right())
+                pending.emplace_back(node->right(), false);
+            if (node->left())
+                pending.emplace_back(node->left(), false);
+            continue;
+        }
+
+        if (node_kinds.size() >= none)
+            throw std::domain_error("Expression is too large to flatten");
+        node->accept(builder);
+        index.emplace(node, static_cast<std::uint32_t>(node_kinds.size()));
+        node_values.push_back(builder.value);
+        node_lefts.push_back(index_of(node->left()));
+        node_rights.push_back(index_of(node->right()));
+        node_kinds.push_back(builder.kind);
+    }
+
+    count = node_kinds.size();
+    storage.reset(new unsigned char[count * (sizeof(int) + 2 * sizeof(std::uint32_t) + sizeof(Kind))]);
+    values = reinterpret_cast<int*>(storage.get());
+    lefts = reinterpret_cast<std::uint32_t*>(values + count);
+    rights = lefts + count;
+    kinds = reinterpret_cast<Kind*>(rights + count);
+    std::memcpy(values, node_values.data(), count * sizeof(int));
+    std::memcpy(lefts, node_lefts.data(), count * sizeof(std::uint32_t));
+    std::memcpy(rights, node_rights.data(), count * sizeof(std::uint32_t));
+    std::memcpy(kinds, node_kinds.data(), count * sizeof(Kind));
+}
+
+std::size_t Flat_Tree::size() const
+{
+    return count;
+}
+
+std::size_t Flat_Tree::bytes() const
+{
+    return count * (sizeof(int) + 2 * sizeof(std::uint32_t) + sizeof(Kind));
+}
+
+std::uint32_t Flat_Tree::root() const
+{
+    return static_cast<std::uint32_t>(count - 1);
+}
+
+int Flat_Tree::item(std::uint32_t node) const
+{
+    return kinds[node] == VARIABLE ? context->get(values[node]) : values[node];
+}
+
+// Each order visits nodes in the same sequence as its Expression_Tree
+// iterator, using a stack (or queue) of indices.
+void Flat_Tree::traverse(const std::string& traversal_order, Flat_Visitor& visitor) const
+{
+    AStack<std::uint32_t> stack;
+
+    if (traversal_order == "pre-order") {
+        stack.push(root());
+        while (!stack.is_empty()) {
+            std::uint32_t node = stack.pop();
+            visitor.visit(*this, node);
+            if (rights[node] != none)
+                stack.push(rights[node]);
+            if (lefts[node] != none)
+                stack.push(lefts[node]);
+        }
+    } else if (traversal_order == "in-order") {
+        // start at the left-most node
+        for (std::uint32_t node = root(); node != none; node = lefts[node])
+            stack.push(node);
+        while (!stack.is_empty()) {
+            std::uint32_t node = stack.pop();
+            visitor.visit(*this, node);
+            for (std::uint32_t next = rights[node]; next != none; next = lefts[next])
+                stack.push(next);
+        }
+    } else if (traversal_order == "post-order") {
+        // the flag is true once the node's children have been visited
+        AStack<std::pair<std::uint32_t, bool>> pending;
+        pending.emplace(root(), false);
+        while (!pending.is_empty()) {
+            auto [node, expanded] = pending.pop();
+            if (expanded) {
+                visitor.visit(*this, node);
+                continue;
+            }
+            pending.emplace(node, true);
+            if (rights[node] != none)
+                pending.emplace(rights[node], false);
+            if (lefts[node] != none)
+                pending.emplace(lefts[node], false);
+        }
+    } else if (traversal_order == "level-order") {
+        LQueue<std::uint32_t> queue;
+        queue.enqueue(root());
+        while (!queue.is_empty()) {
+            std::uint32_t node = queue.dequeue();
+            visitor.visit(*this, node);
+            if (lefts[node] != none)
+                queue.enqueue(lefts[node]);
+            if (rights[node] != none)
+                queue.enqueue(rights[node]);
+        }
+    } else {
+        throw Expression_Tree::Invalid_Iterator(traversal_order);
+    }
+}
+
+void Flat_Tree::print(const std::string& traversal_order, std::ostream& out) const
+{
+    Flat_Print_Visitor print_visitor(out);
+    traverse(traversal_order, print_visitor);
+}
+
+// The nodes are in post-order, so one pass from the first node to the
+// root sees every child before its parent.  Each node's value is kept
+// by index, which also covers nodes with several parents.
+bool Flat_Tree::evaluate(int& result) const
+{
+    std::vector<int> results(count);
+    const int* variables = context ? context->data() : nullptr;
+
+    for (std::size_t node = 0; node < count; ++node) {
+        int lhs = lefts[node] != none ? results[lefts[node]] : 0;
+        int rhs = rights[node] != none ? results[rights[node]] : 0;
+        int& value = results[node];
+
+        switch (kinds[node]) {
+        case NUMBER:
+            value = values[node];
+            break;
+        case VARIABLE:
+            value = variables[values[node]];
+            break;
+        case NEGATE:
+            value = -rhs;
+            break;
+        case FACTORIAL:
+            value = 1;
+            for (int i = lhs; i > 1; --i)
+                value *= i;
+            break;
+        case ADD:
+            value = lhs + rhs;
+            break;
+        case SUBTRACT:
+            value = lhs - rhs;
+            break;
+        case MULTIPLY:
+            value = lhs * rhs;
+            break;
+        case DIVIDE:
+            if (rhs == 0)
+                return false;
+            value = lhs / rhs;
+            break;
+        case MODULUS:
+            if (rhs == 0)
+                return false;
+            value = lhs % rhs;
+            break;
+        case POWER:
+            // same conversion as Evaluation_Visitor
+            value = static_cast<int>(pow(lhs, rhs));
+            break;
+        }
+    }
+
+    result = results[root()];
+    return true;
+}
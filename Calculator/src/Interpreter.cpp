@@ -12,19 +12,17 @@
 
 #include "Interpreter.h"
 #include "Component_Node.h"
-#include "Composite_Add_Node.h"
-#include "Composite_Divide_Node.h"
-#include "Composite_Factorial_Node.h"
-#include "Composite_Modulus_Node.h"
-#include "Composite_Multiply_Node.h"
-#include "Composite_Negate_Node.h"
-#include "Composite_Power_Node.h"
-#include "Composite_Subtract_Node.h"
-#include "Leaf_Node.h"
+#include "Tokenizer.h"
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <memory>
+#include <vector>
+
+// Node of the expression tree being built.
+typedef Component_Node_Factory::Node Node;
 
 /**
  * @class Symbol
@@ -34,17 +32,32 @@ class Symbol {
 public:
     // constructor
     Symbol(Symbol* l, Symbol* r, int precedence = 0);
-    // destructor
-    virtual ~Symbol();
+    // destructor. Symbols live in the Interpreter's Arena and are
+    // released with it, so this never deletes the children.
+    virtual ~Symbol() = default;
+    // allocate the symbol from @a arena
+    static void* operator new(size_t bytes, Arena& arena);
+    // symbols are never deleted one at a time, the arena owns the memory
+    static void operator delete(void*);
+    // only called if a constructor throws; the arena still owns the memory
+    static void operator delete(void*, Arena&);
     // abstract method for returning precedence level (higher
     // value means higher precedence
     virtual int precedence()
     {
         return prec;
     }
-    virtual int add_precedence(int accumulated_precedence) = 0;
+    // moves this symbol's operands off the parser's operand stack
+    // (does nothing for symbols without operands)
+    virtual void take_operands(std::vector<Symbol*>& operands);
+    // throws std::domain_error if one of the symbol's operands is
+    // missing
+    virtual void check_operands() const;
     // abstract method for building an Expression Expression_Tree Node
-    virtual Component_Node* build() = 0;
+    // with the nodes made by @a factory, out of the nodes already built
+    // for the operands
+    virtual Component_Node_Factory::Node build(
+        Component_Node_Factory& factory, const Node& lhs, const Node& rhs) = 0;
     // left and right pointers
     Symbol* left;
     Symbol* right;
@@ -62,6 +75,8 @@ public:
     Operator(Symbol* left, Symbol* right, int precedence = 1);
     // destructor
     ~Operator() override = default;
+    // pops the operand(s) this operator applies to
+    void take_operands(std::vector<Symbol*>& operands) override;
 };
 
 /**
@@ -75,6 +90,8 @@ public:
     explicit Unary_Operator(Symbol* right, int precedence = 1);
     // destructor
     ~Unary_Operator() override = default;
+    // pops the operand(s) this operator applies to
+    void take_operands(std::vector<Symbol*>& operands) override;
 };
 
 /**
@@ -88,6 +105,8 @@ public:
     explicit Left_Unary_Operator(Symbol* left, int precedence = 1);
     // destructor
     ~Left_Unary_Operator() override = default;
+    // pops the operand(s) this operator applies to
+    void take_operands(std::vector<Symbol*>& operands) override;
 };
 
 /**
@@ -96,21 +115,40 @@ public:
  */
 class Number : public Symbol {
 public:
-    // constructors
-    explicit Number(const std::string& input);
+    // constructor
     explicit Number(const int& input);
     // destructor
     ~Number() override = default;
-    // returns the precedence level
-    int add_precedence(int accumulated_precedence) override;
     // builds an equivalent Expression_Tree node
-    Component_Node* build() override;
+    Component_Node_Factory::Node build(
+        Component_Node_Factory& factory, const Node& lhs, const Node& rhs) override;
 
 private:
     // contains the value of the leaf node
     int item;
 };
 
+/**
+ * @class Variable
+ * @brief Leaf node of parse tree that refers to a variable
+ */
+class Variable : public Symbol {
+public:
+    // constructor
+    Variable(const Interpreter_Context& context, int slot);
+    // destructor
+    ~Variable() override = default;
+    // builds an equivalent Expression_Tree node
+    Component_Node_Factory::Node build(
+        Component_Node_Factory& factory, const Node& lhs, const Node& rhs) override;
+
+private:
+    // context that holds the variable
+    const Interpreter_Context& context;
+    // slot of the variable in the context
+    int slot;
+};
+
 /**
  * @class Subtract
  * @brief Subtraction node of the parse tree
@@ -121,10 +159,11 @@ public:
     Subtract();
     // destructor
     ~Subtract() override = default;
-    // returns the precedence level
-    int add_precedence(int accumulated_precedence) override;
     // builds an equivalent Expression_Tree node
-    Component_Node* build() override;
+    Component_Node_Factory::Node build(
+        Component_Node_Factory& factory, const Node& lhs, const Node& rhs) override;
+    // reports a missing operand
+    void check_operands() const override;
 };
 
 /**
@@ -137,10 +176,11 @@ public:
     Add();
     // destructor
     ~Add() override = default;
-    // returns the precedence level
-    int add_precedence(int accumulated_precedence) override;
     // builds an equivalent Expression_Tree node
-    Component_Node* build() override;
+    Component_Node_Factory::Node build(
+        Component_Node_Factory& factory, const Node& lhs, const Node& rhs) override;
+    // reports a missing operand
+    void check_operands() const override;
 };
 
 /**
@@ -153,10 +193,11 @@ public:
     Negate();
     // destructor
     ~Negate() override = default;
-    // returns the precedence level
-    int add_precedence(int accumulated_precedence) override;
     // builds an equivalent Expression_Tree node
-    Component_Node* build() override;
+    Component_Node_Factory::Node build(
+        Component_Node_Factory& factory, const Node& lhs, const Node& rhs) override;
+    // reports a missing operand
+    void check_operands() const override;
 };
 
 /**
@@ -169,10 +210,11 @@ public:
     Factorial();
     // destructor
     ~Factorial() override = default;
-    // returns the precedence level
-    int add_precedence(int accumulated_precedence) override;
     // builds an equivalent Expression_Tree node
-    Component_Node* build() override;
+    Component_Node_Factory::Node build(
+        Component_Node_Factory& factory, const Node& lhs, const Node& rhs) override;
+    // reports a missing operand
+    void check_operands() const override;
 };
 
 /**
@@ -185,10 +227,11 @@ public:
     Multiply();
     // destructor
     ~Multiply() override = default;
-    // returns the precedence level
-    int add_precedence(int accumulated_precedence) override;
     // builds an equivalent Expression_Tree node
-    Component_Node* build() override;
+    Component_Node_Factory::Node build(
+        Component_Node_Factory& factory, const Node& lhs, const Node& rhs) override;
+    // reports a missing operand
+    void check_operands() const override;
 };
 
 /**
@@ -201,10 +244,11 @@ public:
     Divide();
     // destructor
     ~Divide() override = default;
-    // returns the precedence level
-    int add_precedence(int accumulated_precedence) override;
     // builds an equivalent Expression_Tree node
-    Component_Node* build() override;
+    Component_Node_Factory::Node build(
+        Component_Node_Factory& factory, const Node& lhs, const Node& rhs) override;
+    // reports a missing operand
+    void check_operands() const override;
 };
 
 /**
@@ -217,10 +261,11 @@ public:
     Modulus();
     // destructor
     ~Modulus() override = default;
-    // returns the precedence level
-    int add_precedence(int accumulated_precedence) override;
     // builds an equivalent Expression_Tree node
-    Component_Node* build() override;
+    Component_Node_Factory::Node build(
+        Component_Node_Factory& factory, const Node& lhs, const Node& rhs) override;
+    // reports a missing operand
+    void check_operands() const override;
 };
 
 /**
@@ -233,45 +278,141 @@ public:
     Power();
     // destructor
     ~Power() override = default;
-    // returns the precedence level
-    int add_precedence(int accumulated_precedence) override;
     // builds an equivalent Expression_Tree node
-    Component_Node* build() override;
+    Component_Node_Factory::Node build(
+        Component_Node_Factory& factory, const Node& lhs, const Node& rhs) override;
+    // reports a missing operand
+    void check_operands() const override;
 };
 
+// constructor
+Interpreter_Context::Interpreter_Context()
+    : buckets(16, -1)
+{
+}
+
+// hash a variable name (FNV-1a)
+static std::size_t hash_name(std::string_view variable)
+{
+    std::size_t hash = 14695981039346656037ULL;
+    for (char c : variable) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// return the bucket holding a name, or the empty bucket it belongs in
+std::size_t Interpreter_Context::bucket(std::string_view variable) const
+{
+    std::size_t mask = buckets.size() - 1;
+    std::size_t i = hash_name(variable) & mask;
+
+    // linear probing, the table is never more than half full
+    while (buckets[i] != -1 && names[buckets[i]] != variable)
+        i = (i + 1) & mask;
+
+    return i;
+}
+
+// double the table and reinsert every slot
+void Interpreter_Context::grow()
+{
+    buckets.assign(buckets.size() * 2, -1);
+    std::size_t mask = buckets.size() - 1;
+
+    for (int index = 0; index < size(); ++index) {
+        std::size_t i = hash_name(names[index]) & mask;
+        while (buckets[i] != -1)
+            i = (i + 1) & mask;
+        buckets[i] = index;
+    }
+}
+
+// return the slot of a variable, or -1
+int Interpreter_Context::find(std::string_view variable) const
+{
+    return buckets[bucket(variable)];
+}
+
 // return the value of a variable
-int Interpreter_Context::get(std::string variable)
+int Interpreter_Context::get(std::string_view variable) const
 {
-    return map[variable];
+    int index = find(variable);
+    return index == -1 ? 0 : values[index];
 }
 
 // set the value of a variable
-void Interpreter_Context::set(std::string variable, int value)
+void Interpreter_Context::set(std::string_view variable, int value)
 {
-    map[variable] = value;
+    int index = slot(variable);
+    values[index] = value;
+    bound[index] = true;
 }
 
-// print all variables and their values
-void Interpreter_Context::print()
+// set a range of slots at once
+void Interpreter_Context::set(int first_slot, const int* new_values, std::size_t count)
 {
-    for (auto i = map.begin(); i != map.end(); ++i)
-        std::cout << i->first << ": " << i->second << std::endl;
+    std::memcpy(values.data() + first_slot, new_values, count * sizeof(int));
+    std::memset(bound.data() + first_slot, true, count);
 }
 
-// clear all variables and their values
-void Interpreter_Context::reset()
+// return the slot of a variable, adding one if needed
+int Interpreter_Context::slot(std::string_view variable)
 {
-    map.clear();
+    std::size_t i = bucket(variable);
+    if (buckets[i] != -1)
+        return buckets[i];
+
+    int index = size();
+    names.emplace_back(variable);
+    values.push_back(0);
+    bound.push_back(false);
+    buckets[i] = index;
+
+    if (names.size() * 2 > buckets.size())
+        grow();
+
+    return index;
 }
 
-bool Interpreter_Context::exist(std::string variable)
+// return the name of a slot
+const std::string& Interpreter_Context::name(int slot) const
 {
-    std::map<std::string, int>::iterator it = map.find(variable);
-    if (it == map.end()) {
-        return false;
-    } else {
-        return true;
-    }
+    return names[slot];
+}
+
+// return the number of slots
+int Interpreter_Context::size() const
+{
+    return static_cast<int>(names.size());
+}
+
+// return the values of all slots
+const int* Interpreter_Context::data() const
+{
+    return values.data();
+}
+
+// print all variables that have been set and their values, sorted by
+// name
+void Interpreter_Context::print(std::ostream& out)
+{
+    std::vector<int> order;
+    for (int index = 0; index < size(); ++index)
+        if (bound[index])
+            order.push_back(index);
+
+    std::sort(order.begin(), order.end(), [this](int a, int b) { return names[a] < names[b]; });
+
+    for (int index : order)
+        out << names[index] << ": " << values[index] << std::endl;
+}
+
+bool Interpreter_Context::exist(std::string_view variable) const
+{
+    int index = find(variable);
+    return index != -1 && bound[index];
 }
 
 // constructor
@@ -282,11 +423,20 @@ Symbol::Symbol(Symbol* l, Symbol* r, int precedence)
 {
 }
 
-// destructor
-Symbol::~Symbol()
+// allocate the symbol from the arena
+void* Symbol::operator new(size_t bytes, Arena& arena)
+{
+    return arena.allocate(bytes, alignof(Symbol));
+}
+
+// nothing to do, the arena gets the memory back when it is reset
+void Symbol::operator delete(void*)
+{
+}
+
+// nothing to do, the arena gets the memory back when it is reset
+void Symbol::operator delete(void*, Arena&)
 {
-    delete left;
-    delete right;
 }
 
 // constructor
@@ -307,11 +457,37 @@ Unary_Operator::Unary_Operator(Symbol* right, int precedence)
 {
 }
 
-// constructor
-Number::Number(const std::string& input)
-    : Symbol(nullptr, nullptr, 6)
+// by default a symbol has no operands to take
+void Symbol::take_operands(std::vector<Symbol*>&)
+{
+}
+
+// by default a symbol has no operands that can be missing
+void Symbol::check_operands() const
+{
+}
+
+// binary operators take both of their operands
+void Operator::take_operands(std::vector<Symbol*>& operands)
 {
-    item = ::atoi(input.c_str());
+    right = operands.back();
+    operands.pop_back();
+    left = operands.back();
+    operands.pop_back();
+}
+
+// left unary operators (eg factorial) take the operand before them
+void Left_Unary_Operator::take_operands(std::vector<Symbol*>& operands)
+{
+    left = operands.back();
+    operands.pop_back();
+}
+
+// unary operators (eg negate) take the operand after them
+void Unary_Operator::take_operands(std::vector<Symbol*>& operands)
+{
+    right = operands.back();
+    operands.pop_back();
 }
 
 // constructor
@@ -321,16 +497,27 @@ Number::Number(const int& input)
 {
 }
 
-// returns the precedence level
-int Number::add_precedence(int accumulated_precedence)
+// builds an equivalent Expression_Tree node
+Component_Node_Factory::Node Number::build(
+    Component_Node_Factory& factory, const Node&, const Node&)
 {
-    return this->prec = 6 + accumulated_precedence;
+    return factory.make_number(item);
 }
 
-// builds an equivalent Expression_Tree node
-Component_Node* Number::build()
+// constructor
+Variable::Variable(const Interpreter_Context& context, int slot)
+    : Symbol(nullptr, nullptr, 6)
+    , context(context)
+    , slot(slot)
 {
-    return new Leaf_Node(item);
+}
+
+// builds an equivalent Expression_Tree node, which looks the value up
+// whenever it is evaluated
+Component_Node_Factory::Node Variable::build(
+    Component_Node_Factory& factory, const Node&, const Node&)
+{
+    return factory.make_variable(context, slot);
 }
 
 // constructor
@@ -339,20 +526,18 @@ Negate::Negate()
 {
 }
 
-// returns the precedence level
-int Negate::add_precedence(int accumulated_precedence)
+// reports a missing operand
+void Negate::check_operands() const
 {
-    return this->prec = 3 + accumulated_precedence;
+    if (right == nullptr)
+        throw std::domain_error("Expecting right operand to -");
 }
 
 // builds an equivalent Expression_Tree node
-Component_Node* Negate::build()
+Component_Node_Factory::Node Negate::build(
+    Component_Node_Factory& factory, const Node&, const Node& rhs)
 {
-    if (right != nullptr) {
-        return new Composite_Negate_Node(right->build());
-    } else {
-        throw std::domain_error("Expecting right operand to -");
-    }
+    return factory.make_negate(rhs);
 }
 
 Factorial::Factorial()
@@ -360,18 +545,18 @@ Factorial::Factorial()
 {
 }
 
-int Factorial::add_precedence(int accumulated_precedence)
+// reports a missing operand
+void Factorial::check_operands() const
 {
-    return this->prec = 5 + accumulated_precedence;
+    if (left == nullptr)
+        throw std::domain_error("Expecting right operand to !");
 }
 
-Component_Node* Factorial::build()
+// builds an equivalent Expression_Tree node
+Component_Node_Factory::Node Factorial::build(
+    Component_Node_Factory& factory, const Node& lhs, const Node&)
 {
-    if (left != nullptr) {
-        return new Composite_Factorial_Node(left->build());
-    } else {
-        throw std::domain_error("Expecting right operand to !");
-    }
+    return factory.make_factorial(lhs);
 }
 
 // constructor
@@ -380,22 +565,20 @@ Add::Add()
 {
 }
 
-// returns the precedence level
-int Add::add_precedence(int accumulated_precedence)
+// reports a missing operand
+void Add::check_operands() const
 {
-    return this->prec = 1 + accumulated_precedence;
+    if (left == nullptr)
+        throw std::domain_error("Expecting left operand to +");
+    else if (right == nullptr)
+        throw std::domain_error("Expecting right operand to +");
 }
 
 // builds an equivalent Expression_Tree node
-Component_Node* Add::build()
+Component_Node_Factory::Node Add::build(
+    Component_Node_Factory& factory, const Node& lhs, const Node& rhs)
 {
-    if (left == nullptr) {
-        throw std::domain_error("Expecting left operand to +");
-    } else if (right == nullptr) {
-        throw std::domain_error("Expecting right operand to +");
-    } else {
-        return new Composite_Add_Node(left->build(), right->build());
-    }
+    return factory.make_add(lhs, rhs);
 }
 
 // constructor
@@ -404,22 +587,20 @@ Subtract::Subtract()
 {
 }
 
-// returns the precedence level
-int Subtract::add_precedence(int accumulated_precedence)
+// reports a missing operand
+void Subtract::check_operands() const
 {
-    return this->prec = 1 + accumulated_precedence;
+    if (left == nullptr)
+        throw std::domain_error("Expecting left operand to -");
+    else if (right == nullptr)
+        throw std::domain_error("Expecting right operand to -");
 }
 
 // builds an equivalent Expression_Tree node
-Component_Node* Subtract::build()
+Component_Node_Factory::Node Subtract::build(
+    Component_Node_Factory& factory, const Node& lhs, const Node& rhs)
 {
-    if (left == nullptr) {
-        throw std::domain_error("Expecting left operand to -");
-    } else if (right == nullptr) {
-        throw std::domain_error("Expecting right operand to -");
-    } else {
-        return new Composite_Subtract_Node(left->build(), right->build());
-    }
+    return factory.make_subtract(lhs, rhs);
 }
 
 // constructor
@@ -428,22 +609,20 @@ Multiply::Multiply()
 {
 }
 
-// returns the precedence level
-int Multiply::add_precedence(int accumulated_precedence)
+// reports a missing operand
+void Multiply::check_operands() const
 {
-    return this->prec = 2 + accumulated_precedence;
+    if (left == nullptr)
+        throw std::domain_error("Expecting left operand to *");
+    else if (right == nullptr)
+        throw std::domain_error("Expecting right operand to *");
 }
 
 // builds an equivalent Expression_Tree node
-Component_Node* Multiply::build()
+Component_Node_Factory::Node Multiply::build(
+    Component_Node_Factory& factory, const Node& lhs, const Node& rhs)
 {
-    if (left == nullptr) {
-        throw std::domain_error("Expecting left operand to *");
-    } else if (right == nullptr) {
-        throw std::domain_error("Expecting right operand to *");
-    } else {
-        return new Composite_Multiply_Node(left->build(), right->build());
-    }
+    return factory.make_multiply(lhs, rhs);
 }
 
 // constructor
@@ -452,22 +631,20 @@ Divide::Divide()
 {
 }
 
-// returns the precedence level
-int Divide::add_precedence(int accumulated_precedence)
+// reports a missing operand
+void Divide::check_operands() const
 {
-    return this->prec = 2 + accumulated_precedence;
+    if (left == nullptr)
+        throw std::domain_error("Expecting left operand to /");
+    else if (right == nullptr)
+        throw std::domain_error("Expecting right operand to /");
 }
 
 // builds an equivalent Expression_Tree node
-Component_Node* Divide::build()
+Component_Node_Factory::Node Divide::build(
+    Component_Node_Factory& factory, const Node& lhs, const Node& rhs)
 {
-    if (left == nullptr) {
-        throw std::domain_error("Expecting left operand to /");
-    } else if (right == nullptr) {
-        throw std::domain_error("Expecting right operand to /");
-    } else {
-        return new Composite_Divide_Node(left->build(), right->build());
-    }
+    return factory.make_divide(lhs, rhs);
 }
 
 // constructor
@@ -476,22 +653,20 @@ Modulus::Modulus()
 {
 }
 
-// returns the precedence level
-int Modulus::add_precedence(int accumulated_precedence)
+// reports a missing operand
+void Modulus::check_operands() const
 {
-    return this->prec = 2 + accumulated_precedence;
+    if (left == nullptr)
+        throw std::domain_error("Expecting left operand to %");
+    else if (right == nullptr)
+        throw std::domain_error("Expecting right operand to %");
 }
 
 // builds an equivalent Expression_Tree node
-Component_Node* Modulus::build()
+Component_Node_Factory::Node Modulus::build(
+    Component_Node_Factory& factory, const Node& lhs, const Node& rhs)
 {
-    if (left == nullptr) {
-        throw std::domain_error("Expecting left operand to %");
-    } else if (right == nullptr) {
-        throw std::domain_error("Expecting right operand to %");
-    } else {
-        return new Composite_Modulus_Node(left->build(), right->build());
-    }
+    return factory.make_modulus(lhs, rhs);
 }
 
 // constructor
@@ -500,23 +675,27 @@ Power::Power()
 {
 }
 
-// returns the precedence level
-int Power::add_precedence(int accumulated_precedence)
+// reports a missing operand
+void Power::check_operands() const
 {
-    return this->prec = 4 + accumulated_precedence;
-    ;
+    if (left == nullptr)
+        throw std::domain_error("Expecting left operand to ^");
+    else if (right == nullptr)
+        throw std::domain_error("Expecting right operand to ^");
 }
 
 // builds an equivalent Expression_Tree node
-Component_Node* Power::build()
+Component_Node_Factory::Node Power::build(
+    Component_Node_Factory& factory, const Node& lhs, const Node& rhs)
+{
+    return factory.make_power(lhs, rhs);
+}
+
+// constructor
+Interpreter::Interpreter(bool share, std::ostream& errors)
+    : factory(share)
+    , errors(errors)
 {
-    if (left == nullptr) {
-        throw std::domain_error("Expecting left operand to ^");
-    } else if (right == nullptr) {
-        throw std::domain_error("Expecting right operand to ^");
-    } else {
-        return new Composite_Power_Node(left->build(), right->build());
-    }
 }
 
 // method for checking if a character is a valid operator
@@ -540,324 +719,196 @@ bool Interpreter::is_alphanumeric(char input)
         || (input >= '0' && input <= '9');
 }
 
-// inserts a terminal into the parse tree
-void Interpreter::terminal_insert(Symbol* terminal, std::list<Symbol*>& list)
+// makes a variable leaf node out of a variable name
+Symbol* Interpreter::variable_insert(Interpreter_Context& context, std::string_view name)
 {
-    if (!list.empty()) {
-        // Something exists in the list, so make this number the rightmost child
-
-        Symbol* symbol = list.back();
-
-        if (symbol) {
-            // while there is a right child, continue down
-            for (; symbol->right; symbol = symbol->right)
-                continue;
-
-            // symbol right will be this terminal and that's all we have
-            // to do.
-            symbol->right = terminal;
-        }
-    } else
-        // a number appeared first
-        list.push_back(terminal);
+    // the tree refers to the variable's slot rather than copying its
+    // current value, so later "set" commands are picked up by eval
+    return new (arena) Variable(context, context.slot(name));
 }
 
-// inserts a variable (leaf node / number) into the parse tree
-void Interpreter::variable_insert(Interpreter_Context& context, const std::string& input,
-    std::string::size_type& i, int& accumulated_precedence, std::list<Symbol*>& list,
-    Symbol*& lastValidInput)
+// makes a leaf node / number out of a run of digits
+Symbol* Interpreter::number_insert(std::string_view digits)
 {
-    // merge all consecutive number chars into a single
-    // Number symbol, eg '123' = int (123). Scope of j needs
-    // to be outside of the for loop.
-
-    std::string::size_type j = 1;
-
-    for (; i + j <= input.length() && is_alphanumeric(input[i + j]); ++j)
-        continue;
-
-    // lookup the variable in the context
-
-    int value = context.get(input.substr(i, j));
-
-    // make a Number out of the integer
-
-    auto number = new Number(value);
-    number->add_precedence(accumulated_precedence);
-
-    lastValidInput = number;
-
-    // update i to the last character that was a number. the ++i will
-    // update the i at the end of the loop to the next check.
-
-    i += j - 1;
-
-    precedence_insert(number, list);
+    return new (arena) Number(Tokenizer::to_int(digits));
 }
 
-// inserts a leaf node / number into the parse tree
-void Interpreter::number_insert(const std::string& input, std::string::size_type& i,
-    int& accumulated_precedence, std::list<Symbol*>& list, Symbol*& lastValidInput)
+// reduces the operator on top of the operator stack
+void Interpreter::reduce()
 {
-    // merge all consecutive number chars into a single Number symbol,
-    // eg '123' = int (123). Scope of j needs to be outside of the for
-    // loop.
-
-    std::string::size_type j = 1;
-
-    for (; i + j <= input.length() && is_number(input[i + j]); ++j)
-        continue;
-
-    Number* number = new Number(input.substr(i, j));
-    number->add_precedence(accumulated_precedence);
-
-    lastValidInput = number;
-
-    // update i to the last character that was a number. the ++i will
-    // update the i at the end of the loop to the next check.
-
-    i += j - 1;
-
-    precedence_insert(number, list);
+    Symbol* op = operators.back();
+    operators.pop_back();
+    op->take_operands(operands);
+    operands.push_back(op);
 }
 
-// inserts a multiplication or division into the parse tree
-void Interpreter::precedence_insert(Symbol* op, std::list<Symbol*>& list)
+// reduces pending operators that bind at least as tightly as precedence.
+// A nullptr on the operator stack marks an open parenthesis.
+void Interpreter::reduce_while(int precedence)
 {
-    if (!list.empty()) {
-        // if last element was a number, then make that our left_
-
-        Symbol* parent = list.back();
-        Symbol* child = parent->right;
-
-        if (child) {
-            // while there is a child of parent, keep going down the right side
-            for (; child && child->precedence() < op->precedence(); child = child->right)
-                parent = child;
-        }
-
-        if (parent->precedence() < op->precedence()) {
-
-            // op left will be the old child. new parent child will be
-            // the op. To allow infinite negations, we have to check for
-            // unary_operator.
+    while (!operators.empty() && operators.back() && operators.back()->precedence() >= precedence)
+        reduce();
+}
 
-            // **************** This is the culprit
+// builds the nodes bottom up. A symbol's operands are checked when it
+// is first reached and built before it, left one first, so errors are
+// reported in the same order as a recursive build would.
+Component_Node_Factory::Node Interpreter::build(Symbol* root)
+{
+    pending.clear();
+    built.clear();
+    pending.emplace_back(root, false);
 
-            if (!op->left)
-                op->left = child;
+    while (!pending.empty()) {
+        auto [symbol, expanded] = pending.back();
+        pending.pop_back();
 
-            parent->right = op;
+        if (!expanded) {
+            symbol->check_operands();
+            pending.emplace_back(symbol, true);
+            if (symbol->right)
+                pending.emplace_back(symbol->right, false);
+            if (symbol->left)
+                pending.emplace_back(symbol->left, false);
         } else {
-            // this can be one of two things, either we are the same
-            // precedence or we are less precedence than the parent.
-            // this also means different things for unary ops. The
-            // most recent unary op (negate) has a higher precedence
-
-            if (dynamic_cast<Unary_Operator*>(op)) {
-                for (; child && child->precedence() == op->precedence(); child = child->right)
-                    parent = child;
-
-                // I can't think of a valid reason that parent->right would
-                // be possible !0
-
-                parent->right = op;
-            } else {
-                // everything else is evaluated the same. For instance, if
-                // this is 5 * 4 / 2, and we currently have Mult (5,4) in the
-                // list, we need to make parent our left child.
-
-                op->left = parent;
-                list.pop_back();
-                list.push_back(op);
+            Node rhs, lhs;
+            if (symbol->right) {
+                rhs = std::move(built.back());
+                built.pop_back();
             }
+            if (symbol->left) {
+                lhs = std::move(built.back());
+                built.pop_back();
+            }
+            built.push_back(symbol->build(factory, lhs, rhs));
         }
-    } else {
-        list.push_back(op);
     }
-}
-
-void Interpreter::main_loop(Interpreter_Context& context, const std::string& input,
-    std::string::size_type& i, Symbol*& lastValidInput, bool& handled, int& accumulated_precedence,
-    std::list<Symbol*>& list)
-{
-    handled = false;
-    if (is_number(input[i])) {
-        handled = true;
-        // leaf node
-        number_insert(input, i, accumulated_precedence, list, lastValidInput);
-    } else if (is_alphanumeric(input[i])) {
-        handled = true;
-        // variable leaf node
-        variable_insert(context, input, i, accumulated_precedence, list, lastValidInput);
-    } else if (input[i] == '+') {
-        handled = true;
-        // addition operation
-        auto op = new Add();
-        op->add_precedence(accumulated_precedence);
-
-        lastValidInput = nullptr;
-
-        // insert the op according to left-to-right relationships
-        precedence_insert(op, list);
-    } else if (input[i] == '-') {
-        handled = true;
-
-        Symbol* op = nullptr;
-        if (!lastValidInput) {
-            // Negate
-            op = new Negate();
-            op->add_precedence(accumulated_precedence);
-        } else {
-            // Subtract
-            op = new Subtract();
-            op->add_precedence(accumulated_precedence);
-        }
 
-        lastValidInput = nullptr;
-
-        // insert the op according to left-to-right relationships
-        precedence_insert(op, list);
-
-    } else if (input[i] == '!') {
-        handled = true;
-
-        auto op = new Factorial();
-        op->add_precedence(accumulated_precedence);
-
-        // insert the op according to left-to-right relationships
-        precedence_insert(op, list);
-
-    } else if (input[i] == '*') {
-        handled = true;
-        // multiplication operation
-        auto op = new Multiply();
-        op->add_precedence(accumulated_precedence);
-
-        lastValidInput = nullptr;
-
-        // insert the op according to precedence relationships
-        precedence_insert(op, list);
-        // associative_insert (op);
-    } else if (input[i] == '/') {
-        handled = true;
-        // division operation
-        auto op = new Divide();
-        op->add_precedence(accumulated_precedence);
-
-        lastValidInput = nullptr;
-
-        // insert the op according to precedence relationships
-        precedence_insert(op, list);
-    } else if (input[i] == '%') {
-        handled = true;
-        // division operation
-        auto op = new Modulus();
-        op->add_precedence(accumulated_precedence);
-
-        lastValidInput = nullptr;
-
-        // insert the op according to precedence relationships
-        precedence_insert(op, list);
-    } else if (input[i] == '^') {
-        handled = true;
-        // division operation
-        auto op = new Power();
-        op->add_precedence(accumulated_precedence);
-
-        lastValidInput = nullptr;
-
-        // insert the op according to precedence relationships
-        precedence_insert(op, list);
-    } else if (input[i] == '(') {
-        handled = true;
-        handle_parenthesis(
-            context, input, i, lastValidInput, handled, accumulated_precedence, list);
-    } else if (input[i] == ' ' || input[i] == '\n') {
-        handled = true;
-        // skip whitespace
-    } else if (input[i] != ')') {
-        throw std::domain_error("Unrecognized symbol");
-    }
-}
-
-void Interpreter::handle_parenthesis(Interpreter_Context& context, const std::string& input,
-    std::string::size_type& i, Symbol*& lastValidInput, bool& handled, int& accumulated_precedence,
-    std::list<Symbol*>& master_list)
-{
-    /* handle parenthesis is a lot like handling a new interpret.
-       the difference is that we have to worry about how the calling
-       function has its list setup */
-    // std::cerr << "Handling an opening parenthesis.\n";
-
-    accumulated_precedence += 7;
-    std::list<Symbol*> list;
-    handled = false;
-    for (++i; i < input.length(); ++i) {
-        main_loop(context, input, i, lastValidInput, handled, accumulated_precedence, list);
-        if (input[i] == ')') {
-            // std::cerr << "Handling a closing parenthesis.\n";
-            handled = true;
-            //++i;
-            accumulated_precedence -= 7;
-            break;
-        }
-    }
-
-    if (master_list.size() > 0 && list.size() > 0) {
-        Symbol* lastSymbol = master_list.back();
-        auto op = dynamic_cast<Operator*>(lastSymbol);
-        auto unary = dynamic_cast<Unary_Operator*>(lastSymbol);
-
-        // is it a node with 2 children?
-        if (op) {
-            precedence_insert(list.back(), master_list);
-        } else if (unary)
-        // is it a unary node (like negate)
-        {
-            precedence_insert(list.back(), master_list);
-        } else {
-            // is it a terminal node (Number)
-            // error
-        }
-    } else if (list.size() > 0)
-        master_list = list;
-
-    list.clear();
+    Node root_node = std::move(built.back());
+    built.clear();
+    return root_node;
 }
 
 // Converts a string and context into a parse tree and builds an
 // expression tree out of the parse tree.
+//
+// This is an operator precedence parser: operands and pending operators
+// are kept on two explicit stacks, and every operator is pushed and
+// reduced exactly once, so the parse is linear in the length of the
+// input no matter how the expression nests. Binary operators are left
+// associative, a '-' in operand position is a negation and a '!' binds
+// to the operand immediately to its left. A missing operand is stored
+// as a nullptr so the matching build() reports it.
 
 Expression_Tree Interpreter::interpret(Interpreter_Context& context, const std::string& input)
 {
-    std::list<Symbol*> list;
-    // list.clear ();
-    Symbol* lastValidInput = nullptr;
-    bool handled = false;
-    int accumulated_precedence = 0;
+    operands.clear();
+    operators.clear();
+    Tokenizer tokenizer(input);
+    // true when the next token has to be a number, variable, '-' or '('
+    bool expecting_operand = true;
+
+    try {
+        for (auto token = tokenizer.next(); token.kind != Tokenizer::END;
+             token = tokenizer.next()) {
+            char c = token.text[0];
+
+            if (!expecting_operand
+                && (token.kind == Tokenizer::NUMBER || token.kind == Tokenizer::VARIABLE
+                    || token.kind == Tokenizer::LEFT_PAREN)) {
+                throw std::domain_error("Expecting operator before operand");
+            } else if (token.kind == Tokenizer::NUMBER) {
+                // leaf node
+                operands.push_back(number_insert(token.text));
+                expecting_operand = false;
+            } else if (token.kind == Tokenizer::VARIABLE) {
+                // variable leaf node
+                operands.push_back(variable_insert(context, token.text));
+                expecting_operand = false;
+            } else if (token.kind == Tokenizer::LEFT_PAREN) {
+                operators.push_back(nullptr);
+            } else if (c == '-' && expecting_operand) {
+                operators.push_back(new (arena) Negate());
+            } else {
+                if (expecting_operand) {
+                    // the operand is missing, let build() complain about it
+                    operands.push_back(nullptr);
+                    expecting_operand = false;
+                }
+
+                if (token.kind == Tokenizer::RIGHT_PAREN) {
+                    reduce_while(0);
+                    // an unmatched ')' is ignored
+                    if (!operators.empty())
+                        operators.pop_back();
+                } else if (c == '!') {
+                    // factorial binds tighter than anything that can be
+                    // pending, so apply it to the last operand right away
+                    operators.push_back(new (arena) Factorial());
+                    reduce();
+                } else {
+                    Symbol* op = nullptr;
+                    if (c == '+')
+                        op = new (arena) Add();
+                    else if (c == '-')
+                        op = new (arena) Subtract();
+                    else if (c == '*')
+                        op = new (arena) Multiply();
+                    else if (c == '/')
+                        op = new (arena) Divide();
+                    else if (c == '%')
+                        op = new (arena) Modulus();
+                    else
+                        op = new (arena) Power();
+
+                    // everything to the left that binds at least as
+                    // tightly is complete, which makes ops left associative
+                    reduce_while(op->precedence());
+                    operators.push_back(op);
+                    expecting_operand = true;
+                }
+            }
+        }
+    } catch (...) {
+        arena.reset();
+        throw;
+    }
+
+    // If we reach this with no operators and no operands, we didn't have
+    // any symbols.
+    if (operands.empty() && operators.empty())
+        return Expression_Tree();
 
-    for (std::string::size_type i = 0; i < input.length(); ++i) {
-        main_loop(context, input, i, lastValidInput, handled, accumulated_precedence, list);
+    if (expecting_operand)
+        operands.push_back(nullptr);
+
+    // unmatched '(' are closed at the end of the input
+    while (!operators.empty()) {
+        if (operators.back())
+            reduce();
+        else
+            operators.pop_back();
     }
 
-    // if the list has an element in it, then return the back of the list.
-    if (!list.empty()) {
-        // Invoke a recursive Expression_Tree build starting with the
-        // root symbol. This is an example of the builder pattern. See
-        // pg 97 in GoF book.
-        Expression_Tree tree;
+    Symbol* root = operands.back();
+    Expression_Tree tree;
+
+    if (root) {
+        // Build the Expression_Tree starting with the root symbol.
+        // This is an example of the builder pattern. See pg 97 in GoF
+        // book.
         try {
-            tree = Expression_Tree(list.back()->build());
+            tree = Expression_Tree(build(root));
         } catch (const std::domain_error& err) {
-            std::cout << "Error: " << err.what() << "\n";
+            errors << "Error: " << err.what() << "\n";
         }
-        delete list.back();
-        return tree;
     }
 
-    // If we reach this, we didn't have any symbols.
-    return Expression_Tree();
+    // the parse tree is no longer needed, release all of it at once
+    built.clear();
+    arena.reset();
+    factory.clear();
+    return tree;
 }
 
 #endif // INTERPRETER_CPP
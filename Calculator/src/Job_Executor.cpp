@@ -0,0 +1,120 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#include "Job_Executor.h"
+#include "Bytecode.h"
+#include "Optimization_Visitor.h"
+#include "Options.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+Job_Executor::Job_Executor(std::size_t threads)
+    : pool(threads)
+    , worker_jobs(pool.size(), 0)
+    , elapsed(0)
+{
+}
+
+std::vector<Job_Executor::Result> Job_Executor::run(const std::vector<Job>& jobs)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // parse every distinct expression once; the interpreter, the
+    // optimizer and compiling aren't thread safe, so this is serial
+    std::vector<std::unique_ptr<Program>> programs;
+    std::unordered_map<std::string_view, std::size_t> index;
+    std::vector<std::size_t> job_program(jobs.size());
+    // the results go to stdout in order, so errors go to stderr
+    Interpreter interpreter(Options::instance()->share_subtrees(), std::cerr);
+
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        auto found = index.find(jobs[i].expression);
+        if (found != index.end()) {
+            job_program[i] = found->second;
+            continue;
+        }
+
+        programs.emplace_back(new Program);
+        Program& program = *programs.back();
+        try {
+            program.tree = interpreter.interpret(program.context, jobs[i].expression);
+        } catch (std::domain_error&) {
+            program.tree = Expression_Tree();
+        }
+        if (!program.tree.is_null()) {
+            if (Options::instance()->optimize()) {
+                Optimization_Visitor optimizer(Options::instance()->share_subtrees());
+                program.tree = optimizer.optimize(program.tree);
+            }
+            program.tree.bytecode();
+        }
+        job_program[i] = programs.size() - 1;
+        index.emplace(jobs[i].expression, job_program[i]);
+    }
+
+    // enough chunks for stealing to even out the workers, but not so
+    // many that queueing them costs more than the jobs
+    std::vector<Result> results(jobs.size());
+    const std::size_t chunk
+        = std::max<std::size_t>(1, std::min<std::size_t>(1024, jobs.size() / (pool.size() * 8)));
+
+    for (std::size_t first = 0; first < jobs.size(); first += chunk) {
+        const std::size_t last = std::min(first + chunk, jobs.size());
+        pool.submit([&, first, last] {
+            std::vector<int> variables;
+            for (std::size_t i = first; i < last; ++i) {
+                const Program& program = *programs[job_program[i]];
+                if (program.tree.is_null()) {
+                    results[i] = Result { INVALID_EXPRESSION, 0 };
+                    continue;
+                }
+                const Interpreter_Context& context = program.context;
+                variables.assign(context.data(), context.data() + context.size());
+                for (const auto& binding : jobs[i].bindings) {
+                    int slot = context.find(binding.first);
+                    if (slot >= 0)
+                        variables[slot] = binding.second;
+                }
+                int value = 0;
+                Bytecode::Opcode failed = Bytecode::DIVIDE;
+                if (program.tree.bytecode().evaluate(variables.data(), value, &failed))
+                    results[i] = Result { OK, value };
+                else
+                    results[i] = Result {
+                        failed == Bytecode::MODULUS ? MODULUS_BY_ZERO : DIVISION_BY_ZERO, 0
+                    };
+            }
+            worker_jobs[pool.worker()] += last - first;
+        });
+    }
+    pool.wait();
+
+    elapsed += std::chrono::steady_clock::now() - start;
+    return results;
+}
+
+void Job_Executor::print_statistics(std::ostream& out) const
+{
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        Thread_Pool::Statistics statistics = pool.statistics(i);
+        double seconds = std::chrono::duration<double>(statistics.busy).count();
+        out << "worker " << i << ": " << worker_jobs[i] << " jobs, " << statistics.executed
+            << " chunks (" << statistics.stolen << " stolen), " << std::fixed
+            << std::setprecision(0) << (seconds > 0 ? worker_jobs[i] / seconds : 0.0)
+            << " jobs/s" << std::endl;
+        total += worker_jobs[i];
+    }
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    out << "total: " << total << " jobs, " << std::fixed << std::setprecision(0)
+        << (seconds > 0 ? total / seconds : 0.0) << " jobs/s" << std::endl;
+}
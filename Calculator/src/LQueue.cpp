@@ -4,12 +4,14 @@
 
 #include "LQueue.h"
 #include <algorithm>
-#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 /**
  * @class LQueue_Node
- * @brief Defines a node in the @a LQueue that's implemented as a circular
- * linked list.
+ * @brief Defines a chunk of items in the @a LQueue, which is
+ * implemented as a ring of these nodes.
  */
 template <typename T> class LQueue_Node {
     friend class LQueue<T>;
@@ -19,137 +21,123 @@ template <typename T> class LQueue_Node {
     friend class LQueue_Const_Iterator<T>;
 
 public:
-    /// Constructor.
-    LQueue_Node(const T& item, LQueue_Node<T>* next = 0);
+    /// Number of items in a node, about a kilobyte's worth.
+    static constexpr size_t capacity = sizeof(T) >= 64 ? 16 : 1024 / sizeof(T);
 
-    /// Constructor.
-    LQueue_Node(LQueue_Node<T>* next);
+    /// Get a node from this thread's free list, or from the global @a
+    /// ::operator new if that's empty.
+    static LQueue_Node<T>* allocate();
 
-    /// Default constructor that doesn't initialize <item_>.
-    LQueue_Node();
+    /// Return @a node to this thread's free list.
+    static void release(LQueue_Node<T>* node);
 
-    /// Allocate a new <LQueue_Node>, trying first from the @a free_list_
-    /// and if that's empty try from the global @a ::operator new.
-    void* operator new(size_t bytes);
-
-    /// Return @a ptr to the @a free_list_.
-    void operator delete(void* ptr);
-
-    /// Return the next node to which this node points.
-    LQueue_Node* next();
-
-    /// Preallocate n @a LQueue_Nodes and store them on the @a
-    /// free_list_.
+    /// Preallocate n @a LQueue_Nodes and store them on this thread's
+    /// free list.
     static void free_list_allocate(size_t n);
 
-    /// Returns all dynamic memory on the free list to the free store.
+    /// Returns all dynamic memory on this thread's free list to the
+    /// free store.
     static void free_list_release();
 
 private:
-    /// Head of the free list, which is a stack of @a LQueue_Nodes
-    /// used to speed up allocation.
-    static LQueue_Node<T>* free_list;
+    /**
+     * @struct Free_List
+     * @brief Stack of unused nodes kept by one thread, freed when the
+     *        thread exits.
+     */
+    struct Free_List {
+        LQueue_Node<T>* top = nullptr;
+        ~Free_List();
+    };
+
+    /// Return this thread's free list.
+    static Free_List& free_list();
+
+    /// Set once this thread's free list is destroyed, so nodes released
+    /// later are deleted instead.
+    static thread_local bool free_list_closed;
 
-    /// Item in this node.
-    T item;
+    /// Return the item at @a index.
+    T* item(size_t index);
+
+    /// Storage for the items, which are constructed in place.
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type items[capacity];
 
     /// Pointer to the next node.
     LQueue_Node<T>* nextPtr;
 };
 
 /* static */
-template <typename T> LQueue_Node<T>* LQueue_Node<T>::free_list = 0;
-
-// Allocate a new <LQueue_Node>, trying first from the
-// <free_list_> and if that's empty try from the global <::operator
-// new>.
+template <typename T> thread_local bool LQueue_Node<T>::free_list_closed = false;
 
-template <typename T> void* LQueue_Node<T>::operator new(size_t)
+template <typename T> LQueue_Node<T>::Free_List::~Free_List()
 {
-    // extract element from the free_list_ if there is one left
-    if (LQueue_Node<T>::free_list != 0) {
-        // get the top element of the list
-        LQueue_Node<T>* new_node = LQueue_Node<T>::free_list;
-
-        // "remove" the element from the list and pass it to the caller
-        LQueue_Node<T>::free_list = new_node->nextPtr;
-
-        return new_node;
+    free_list_closed = true;
+    while (top != nullptr) {
+        LQueue_Node<T>* node = top;
+        top = node->nextPtr;
+        delete node;
     }
-
-    return ::operator new(sizeof(LQueue_Node<T>));
 }
 
-// Return <ptr> to the <free_list_>.
-template <typename T> void LQueue_Node<T>::operator delete(void* ptr)
+template <typename T> typename LQueue_Node<T>::Free_List& LQueue_Node<T>::free_list()
 {
-    // do nothing on a null pointer
-    if (ptr != 0) {
-        // cast to a node pointer
-        LQueue_Node<T>* node = static_cast<LQueue_Node<T>*>(ptr);
+    static thread_local Free_List list;
+    return list;
+}
 
-        // put the node back into the list
-        node->nextPtr = LQueue_Node<T>::free_list;
+// Get a node from this thread's free list, or from the global
+// <::operator new> if that's empty.
+template <typename T> LQueue_Node<T>* LQueue_Node<T>::allocate()
+{
+    Free_List& list = free_list();
 
-        LQueue_Node<T>::free_list = node;
+    // extract element from the free list if there is one left
+    if (list.top != nullptr) {
+        LQueue_Node<T>* node = list.top;
+        list.top = node->nextPtr;
+        return node;
     }
+
+    return new LQueue_Node<T>;
 }
 
-// Returns the next node to which this node points.
-template <typename T> LQueue_Node<T>* LQueue_Node<T>::next()
+// Return <node> to this thread's free list.
+template <typename T> void LQueue_Node<T>::release(LQueue_Node<T>* node)
 {
-    return next;
+    if (free_list_closed) {
+        delete node;
+        return;
+    }
+
+    Free_List& list = free_list();
+    node->nextPtr = list.top;
+    list.top = node;
 }
 
 // Returns all dynamic memory on the free list to the free store.
-
 template <typename T> void LQueue_Node<T>::free_list_release()
 {
+    Free_List& list = free_list();
+
     // delete free list element by element
-    while (LQueue_Node<T>::free_list != 0) {
-        LQueue_Node<T>* node = LQueue_Node<T>::free_list;
-        LQueue_Node<T>::free_list = node->nextPtr;
-        ::operator delete(node);
+    while (list.top != nullptr) {
+        LQueue_Node<T>* node = list.top;
+        list.top = node->nextPtr;
+        delete node;
     }
 }
 
-// Preallocate <n> <LQueue_Nodes> and store them on the
-// <free_list_>.
-
+// Preallocate <n> <LQueue_Nodes> and store them on the free list.
 template <typename T> void LQueue_Node<T>::free_list_allocate(size_t n)
 {
-    // add a new element to the stack n times
-    for (size_t node_number = 0; node_number < n; ++node_number) {
-        // create a new element avoiding the overwritten new operator
-        LQueue_Node<T>* new_node
-            = reinterpret_cast<LQueue_Node<T>*>(::operator new(sizeof(LQueue_Node<T>)));
-
-        new_node->nextPtr = LQueue_Node<T>::free_list;
-
-        // make the new element the top of the list
-        LQueue_Node<T>::free_list = new_node;
-    }
+    for (size_t node_number = 0; node_number < n; ++node_number)
+        release(new LQueue_Node<T>);
 }
 
-template <typename T>
-LQueue_Node<T>::LQueue_Node(const T& item, LQueue_Node<T>* next)
-    : item(item)
-    , nextPtr(next)
-{
-}
-
-template <typename T>
-LQueue_Node<T>::LQueue_Node(LQueue_Node<T>* next)
-    : nextPtr(next)
-{
-}
-
-// This method is helpful to implement the dummy node in a concise
-// way.
-template <typename T>
-LQueue_Node<T>::LQueue_Node()
-    : nextPtr(this)
+template <typename T> T* LQueue_Node<T>::item(size_t index)
 {
+    return std::launder(reinterpret_cast<T*>(&items[index]));
 }
 
 // Returns the current size.
@@ -163,14 +151,16 @@ template <typename T> size_t LQueue<T>::size() const
 template <typename T>
 LQueue<T>::LQueue(size_t size_hint)
     // Initialize fields here.
-    : tail(0)
+    : head(nullptr)
+    , tail(nullptr)
+    , first(0)
+    , last(0)
     , count(0)
 {
-    // use the size_hint to preallocate  memory for nodes
-    LQueue_Node<T>::free_list_allocate(size_hint);
-
-    // create the dummy node
-    tail = new LQueue_Node<T>();
+    // use the size_hint to preallocate memory for nodes; the first
+    // node is allocated by the first enqueue
+    LQueue_Node<T>::free_list_allocate(
+        (size_hint + LQueue_Node<T>::capacity - 1) / LQueue_Node<T>::capacity);
 }
 
 // Copy constructor.
@@ -178,24 +168,30 @@ LQueue<T>::LQueue(size_t size_hint)
 template <typename T>
 LQueue<T>::LQueue(const LQueue<T>& rhs)
     // Initialize fields here.
-    : tail(nullptr)
+    : head(nullptr)
+    , tail(nullptr)
+    , first(0)
+    , last(0)
     , count(0) // count will be set correctly by copy_list
 {
-    // insert a dummy node first and keep it as an unique_ptr for exception
-    // safety issues
-    std::unique_ptr<LQueue_Node<T>> tempTail(new LQueue_Node<T>());
-    tail = tempTail.get();
-
     // copy_list has strong exception safety, so no try catch block
     // is necessary here
     copy_list(rhs);
+}
 
-    // from here on, the unique_ptr should not try to delete the
-    // tail pointer anymore.
-    tempTail.release();
+// Move constructor.
+template <typename T>
+LQueue<T>::LQueue(LQueue<T>&& rhs) noexcept
+    : head(nullptr)
+    , tail(nullptr)
+    , first(0)
+    , last(0)
+    , count(0)
+{
+    swap(rhs);
 }
 
-// Copy a linked list of nodes
+// Copy the items of another queue.
 template <typename T> void LQueue<T>::copy_list(const LQueue<T>& rhs)
 {
     LQueue<T> temp;
@@ -206,21 +202,40 @@ template <typename T> void LQueue<T>::copy_list(const LQueue<T>& rhs)
     }
 
     // we only swap the lists if the temporary list has been successfully
-    // created. This ensures strong exception guarantees.
-    std::swap(tail, temp.tail);
-
-    // swap the counts too
-    std::swap(count, temp.count);
+    // created. This ensures strong exception guarantees.  The old items
+    // go away with the temporary.
+    swap(temp);
 }
 
-// Delete a linked list of nodes
+// Destroy all items and give the nodes back to the free list.
 template <typename T> void LQueue<T>::delete_list()
 {
-    // we do not delete the dummy node here. This will be done in the destructor
-    // we dequeue all elements until the queue is empty again
     while (!is_empty()) {
         dequeue_i();
     }
+
+    if (head != nullptr) {
+        // break the ring, then release it node by node
+        LQueue_Node<T>* node = head->nextPtr;
+        head->nextPtr = nullptr;
+        while (node != nullptr) {
+            LQueue_Node<T>* next = node->nextPtr;
+            LQueue_Node<T>::release(node);
+            node = next;
+        }
+        head = tail = nullptr;
+        first = last = 0;
+    }
+}
+
+// Exchange the contents of this queue with <rhs>.
+template <typename T> void LQueue<T>::swap(LQueue<T>& rhs) noexcept
+{
+    std::swap(head, rhs.head);
+    std::swap(tail, rhs.tail);
+    std::swap(first, rhs.first);
+    std::swap(last, rhs.last);
+    std::swap(count, rhs.count);
 }
 
 // Assignment operator.
@@ -228,25 +243,30 @@ template <typename T> LQueue<T>& LQueue<T>::operator=(const LQueue<T>& rhs)
 {
     // test for self assignment first
     if (this != &rhs) {
-        // delete old data of the rhs
-        delete_list();
-
-        // copy new data
+        // copy new data, the old data is deleted with the copy
         copy_list(rhs);
     }
 
     return *this;
 }
 
+// Move assignment operator.
+template <typename T> LQueue<T>& LQueue<T>::operator=(LQueue<T>&& rhs) noexcept
+{
+    if (this != &rhs) {
+        delete_list();
+        swap(rhs);
+    }
+
+    return *this;
+}
+
 // Perform actions needed when queue goes out of scope.
 
 template <typename T> LQueue<T>::~LQueue()
 {
     // delete all elements of the list
     delete_list();
-
-    // delete the last dummy node here
-    delete tail;
 }
 
 // Compare this queue with <rhs> for equality.  Returns true if the
@@ -271,24 +291,54 @@ template <typename T> bool LQueue<T>::operator!=(const LQueue<T>& rhs) const
 
 template <typename T> void LQueue<T>::enqueue(const T& new_item)
 {
-    try {
-        // assign the value to the tail element before the new allocation
-        // to make sure that exceptions thrown in the assignment operator
-        // of T does leave the queue structure altered
-        tail->item = new_item;
+    emplace(new_item);
+}
 
-        // integrate the new node into the list
-        tail->nextPtr = new LQueue_Node<T>(tail->nextPtr);
-        tail = tail->nextPtr;
+// Move a <new_item> to the tail of the queue.
+template <typename T> void LQueue<T>::enqueue(T&& new_item)
+{
+    emplace(std::move(new_item));
+}
+
+// Construct an item at the tail of the queue.  Throws the <Overflow>
+// exception if no node can be allocated.
+template <typename T> template <typename... Args> void LQueue<T>::emplace(Args&&... args)
+{
+    LQueue_Node<T>* node = tail;
+    size_t index = last;
 
-        // increment the element count
-        ++count;
+    try {
+        if (node == nullptr) {
+            // the first node of the ring
+            node = head = tail = LQueue_Node<T>::allocate();
+            node->nextPtr = node;
+        } else if (index == LQueue_Node<T>::capacity) {
+            // the tail is full, so move on to the spare node after it
+            // or link a new one in
+            if (tail->nextPtr == head) {
+                LQueue_Node<T>* spare = LQueue_Node<T>::allocate();
+                spare->nextPtr = head;
+                tail->nextPtr = spare;
+            }
+            node = tail->nextPtr;
+            index = 0;
+        }
     } catch (const std::bad_alloc&) {
         // we transform a bad_alloc exception into an overflow exception,
         // because it basically means, that it is no longer possible
         // to enqueue new elements
         throw Overflow();
     }
+
+    // construct the item before moving the tail, so an exception thrown
+    // by T leaves the queue unaltered
+    new (node->item(index)) T(std::forward<Args>(args)...);
+
+    tail = node;
+    last = index + 1;
+
+    // increment the element count
+    ++count;
 }
 
 // Remove and return the front item on the queue.
@@ -301,10 +351,8 @@ template <typename T> T LQueue<T>::dequeue()
         throw Underflow();
     }
 
-    // extract the value of the head node. This is done before we actually
-    // remove the element for exceptions could be thrown in the assignment
-    // operator.
-    T item = tail->nextPtr->item;
+    // move the value out of the head node before it is destroyed
+    T item(std::move(*head->item(first)));
 
     // call actual dequeue implementation
     dequeue_i();
@@ -314,14 +362,26 @@ template <typename T> T LQueue<T>::dequeue()
 
 template <typename T> void LQueue<T>::dequeue_i()
 {
-    // remember the current queue head
-    LQueue_Node<T>* head = tail->nextPtr;
-    // remove the head from the queue
-    tail->nextPtr = head->nextPtr;
+    head->item(first)->~T();
+    ++first;
     // decrement the element count
     --count;
-    // delete the old head node
-    delete head;
+
+    if (count == 0) {
+        // start over at the beginning of the node
+        first = last = 0;
+    } else if (first == LQueue_Node<T>::capacity) {
+        // the head node is drained.  It is right after the tail, or
+        // after a spare node, so keep it as the spare unless there
+        // already is one.
+        LQueue_Node<T>* drained = head;
+        head = head->nextPtr;
+        first = 0;
+        if (tail->nextPtr != drained) {
+            tail->nextPtr->nextPtr = head;
+            LQueue_Node<T>::release(drained);
+        }
+    }
 }
 
 // Returns the front queue item without removing it.
@@ -334,7 +394,7 @@ template <typename T> T LQueue<T>::front() const
         throw Underflow();
 
     // return the item in head
-    return tail->nextPtr->item;
+    return *head->item(first);
 }
 
 // Returns true if the queue is empty, otherwise returns false.
@@ -356,44 +416,48 @@ template <typename T> bool LQueue<T>::is_full() const
 template <typename T> typename LQueue<T>::iterator LQueue<T>::begin()
 {
     // iterator starts at the head element
-    return typename LQueue<T>::iterator(*this, tail->next);
+    return typename LQueue<T>::iterator(*this, head, first);
 }
 
 // Get an iterator pointing past the end of the queue
 template <typename T> typename LQueue<T>::iterator LQueue<T>::end()
 {
-    // iterator starts at the tail element
-    return typename LQueue<T>::iterator(*this, tail);
+    // iterator ends after the tail element
+    return typename LQueue<T>::iterator(*this, tail, last);
 }
 
 // Get an iterator to the begining of the queue
 template <typename T> typename LQueue<T>::const_iterator LQueue<T>::begin() const
 {
     // iterator starts at the head element
-    return typename LQueue<T>::const_iterator(*this, tail->nextPtr);
+    return typename LQueue<T>::const_iterator(*this, head, first);
 }
 
 // Get an iterator pointing past the end of the queue
 template <typename T> typename LQueue<T>::const_iterator LQueue<T>::end() const
 {
-    // iterator starts at the tail element
-    return typename LQueue<T>::const_iterator(*this, tail);
+    // iterator ends after the tail element
+    return typename LQueue<T>::const_iterator(*this, tail, last);
 }
 
 template <typename T> T& LQueue_Iterator<T>::operator*()
 {
-    return pos->item;
+    return *node->item(index);
 }
 
 template <typename T> const T& LQueue_Iterator<T>::operator*() const
 {
-    return pos->item;
+    return *node->item(index);
 }
 
 template <typename T> LQueue_Iterator<T>& LQueue_Iterator<T>::operator++()
 {
-    // advance to the next position
-    pos = pos->next;
+    // advance to the next position, which is in the next node unless
+    // this is the tail node, whose end is the end of the queue
+    if (++index == LQueue_Node<T>::capacity && node != queue.tail) {
+        node = node->nextPtr;
+        index = 0;
+    }
 
     return *this;
 }
@@ -405,7 +469,7 @@ template <typename T> LQueue_Iterator<T> LQueue_Iterator<T>::operator++(int)
     LQueue_Iterator<T> copy = *this;
 
     // advance to the next position
-    pos = pos->next;
+    ++*this;
 
     // return original iterator
     return copy;
@@ -416,7 +480,7 @@ template <typename T> bool LQueue_Iterator<T>::operator==(const LQueue_Iterator<
     // check if the iterator points to the same position in the same queue
     // (we could even omit the check for queue equality, because it is
     //  very unlikely that two queues share the same node pointer)
-    return (pos == rhs.pos);
+    return node == rhs.node && index == rhs.index;
 }
 
 template <typename T> bool LQueue_Iterator<T>::operator!=(const LQueue_Iterator<T>& rhs) const
@@ -428,32 +492,36 @@ template <typename T> bool LQueue_Iterator<T>::operator!=(const LQueue_Iterator<
 template <typename T>
 LQueue_Iterator<T>::LQueue_Iterator(LQueue<T>& queue, size_t position)
     : queue(queue)
-    , pos(queue.tail->next)
+    , node(queue.head)
+    , index(queue.first)
 {
-    // iterator over the queue unto the right position
-    // we save iterations for values > count_ by doing modulo calculations
-    for (position = position % (queue.count - 1); position > 0; --position) {
+    // iterate over the queue unto the right position, or the end
+    for (position = std::min(position, queue.count); position > 0; --position) {
         // advance one position each time
-        pos = pos->next;
+        ++*this;
     }
 }
 
 template <typename T>
-LQueue_Iterator<T>::LQueue_Iterator(LQueue<T>& queue, LQueue_Node<T>* pos)
+LQueue_Iterator<T>::LQueue_Iterator(LQueue<T>& queue, LQueue_Node<T>* node, size_t index)
     : queue(queue)
-    , pos(pos)
+    , node(node)
+    , index(index)
 {
 }
 
 template <typename T> const T& LQueue_Const_Iterator<T>::operator*() const
 {
-    return pos->item;
+    return *node->item(index);
 }
 
 template <typename T> const LQueue_Const_Iterator<T>& LQueue_Const_Iterator<T>::operator++() const
 {
     // advance to the next position
-    pos = pos->nextPtr;
+    if (++index == LQueue_Node<T>::capacity && node != queue.tail) {
+        node = node->nextPtr;
+        index = 0;
+    }
     return *this;
 }
 
@@ -462,7 +530,7 @@ template <typename T> LQueue_Const_Iterator<T> LQueue_Const_Iterator<T>::operato
     // keep copy of the original iterator
     LQueue_Const_Iterator<T> copy = *this;
     // advance to the next position
-    pos = pos->next;
+    ++*this;
     // return original iterator
     return copy;
 }
@@ -471,7 +539,7 @@ template <typename T>
 bool LQueue_Const_Iterator<T>::operator==(const LQueue_Const_Iterator<T>& rhs) const
 {
     // check if the iterator points to the same position in the same queue
-    return (pos == rhs.pos);
+    return node == rhs.node && index == rhs.index;
 }
 
 template <typename T>
@@ -483,20 +551,22 @@ bool LQueue_Const_Iterator<T>::operator!=(const LQueue_Const_Iterator<T>& rhs) c
 template <typename T>
 LQueue_Const_Iterator<T>::LQueue_Const_Iterator(const LQueue<T>& queue, size_t position)
     : queue(queue)
-    , pos(queue.tail->next)
+    , node(queue.head)
+    , index(queue.first)
 {
-    // iterator over the queue unto the right position
-    // we save iterations for values > count_ by doing modulo calculations
-    for (position = position % (queue.count - 1); position > 0; --position) {
+    // iterate over the queue unto the right position, or the end
+    for (position = std::min(position, queue.count); position > 0; --position) {
         // advance one position each time
-        pos = pos->next;
+        ++*this;
     }
 }
 
 template <typename T>
-LQueue_Const_Iterator<T>::LQueue_Const_Iterator(const LQueue<T>& queue, LQueue_Node<T>* pos)
+LQueue_Const_Iterator<T>::LQueue_Const_Iterator(
+    const LQueue<T>& queue, LQueue_Node<T>* node, size_t index)
     : queue(queue)
-    , pos(pos)
+    , node(node)
+    , index(index)
 {
 }
 
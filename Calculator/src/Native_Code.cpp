@@ -0,0 +1,293 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#include "Native_Code.h"
+#include "Bytecode.h"
+#include "Interpreter.h"
+#include <cstdint>
+#include <cstring>
+#include <math.h>
+#include <vector>
+
+#if defined(__x86_64__) && defined(__linux__)
+#include <sys/mman.h>
+#define NATIVE_CODE_SUPPORTED 1
+#else
+#define NATIVE_CODE_SUPPORTED 0
+#endif
+
+namespace {
+
+// Programs bigger than this stay bytecode.
+const std::size_t max_instructions = 1 << 16;
+// Every value takes 8 bytes of the hardware stack, so keep deep
+// programs off it.
+const std::size_t max_depth = 4096;
+
+// Called by the generated code, with the same conversion as
+// Evaluation_Visitor.
+int power(int base, int exponent)
+{
+    return static_cast<int>(pow(base, exponent));
+}
+
+// Called by the generated code.
+int factorial(int value)
+{
+    int result = 1;
+    for (int i = value; i > 1; --i)
+        result *= i;
+    return result;
+}
+
+/**
+ * @class Assembler
+ * @brief Appends x86-64 instructions to a buffer.
+ */
+class Assembler {
+public:
+    // Append raw bytes.
+    void emit(std::initializer_list<std::uint8_t> bytes)
+    {
+        code.insert(code.end(), bytes);
+    }
+
+    // Append a 32-bit little-endian value.
+    void emit32(std::int32_t value)
+    {
+        std::uint8_t bytes[4];
+        std::memcpy(bytes, &value, 4);
+        code.insert(code.end(), bytes, bytes + 4);
+    }
+
+    // Append a 64-bit little-endian value.
+    void emit64(std::uint64_t value)
+    {
+        std::uint8_t bytes[8];
+        std::memcpy(bytes, &value, 8);
+        code.insert(code.end(), bytes, bytes + 8);
+    }
+
+    // jz to the failure exit, patched by finish()
+    void jump_to_failure_if_zero()
+    {
+        emit({ 0x0F, 0x84 });
+        failures.push_back(code.size());
+        emit32(0);
+    }
+
+    // Call a helper taking one or two ints in edi/esi; its result
+    // ends up in eax. @a pushed is the number of values on the
+    // hardware stack; the stack has to be 16-byte aligned at the call.
+    void call(const void* helper, std::size_t pushed)
+    {
+        // rsp is 16-byte aligned with an odd number of values pushed
+        bool pad = pushed % 2 == 0;
+        if (pad)
+            emit({ 0x48, 0x83, 0xEC, 0x08 }); // sub rsp, 8
+        emit({ 0x48, 0xB8 }); // mov rax, helper
+        emit64(reinterpret_cast<std::uint64_t>(helper));
+        emit({ 0xFF, 0xD0 }); // call rax
+        if (pad)
+            emit({ 0x48, 0x83, 0xC4, 0x08 }); // add rsp, 8
+    }
+
+    // Append the failure exit and point every failure jump at it.
+    void finish()
+    {
+        std::size_t failure = code.size();
+        emit({ 0x31, 0xC0 }); // xor eax, eax
+        epilogue();
+
+        for (std::size_t at : failures) {
+            std::int32_t offset = static_cast<std::int32_t>(failure - (at + 4));
+            std::memcpy(&code[at], &offset, 4);
+        }
+    }
+
+    // Restore the callee-saved registers and return eax.
+    void epilogue()
+    {
+        emit({ 0x48, 0x8D, 0x65, 0xF0 }); // lea rsp, [rbp - 16]
+        emit({ 0x41, 0x5C }); // pop r12
+        emit({ 0x5B }); // pop rbx
+        emit({ 0x5D }); // pop rbp
+        emit({ 0xC3 }); // ret
+    }
+
+    std::vector<std::uint8_t> code;
+
+private:
+    // Positions of the rel32 fields of the failure jumps.
+    std::vector<std::size_t> failures;
+};
+
+// Translate the program. The generated function keeps the variables in
+// rbx, the temporaries in r12 and the result pointer at [rbp - 24].  The
+// top of the value stack is kept in eax and the rest of it on the
+// hardware stack, so every value pushes the previous top (the first
+// push saves a meaningless eax).
+std::vector<std::uint8_t> translate(const Bytecode& bytecode)
+{
+    Assembler a;
+    a.emit({ 0x55 }); // push rbp
+    a.emit({ 0x48, 0x89, 0xE5 }); // mov rbp, rsp
+    a.emit({ 0x53 }); // push rbx
+    a.emit({ 0x41, 0x54 }); // push r12
+    a.emit({ 0x48, 0x89, 0xFB }); // mov rbx, rdi
+    a.emit({ 0x49, 0x89, 0xF4 }); // mov r12, rsi
+    a.emit({ 0x52 }); // push rdx
+
+    // number of values pushed on the hardware stack
+    std::size_t pushed = 0;
+    for (const Bytecode::Instruction& instruction : bytecode.program()) {
+        std::int32_t offset = instruction.operand * 4;
+
+        switch (instruction.op) {
+        case Bytecode::NUMBER:
+            a.emit({ 0x50 }); // push rax
+            a.emit({ 0xB8 }); // mov eax, imm32
+            a.emit32(instruction.operand);
+            ++pushed;
+            break;
+        case Bytecode::VARIABLE:
+            a.emit({ 0x50 }); // push rax
+            a.emit({ 0x8B, 0x83 }); // mov eax, [rbx + offset]
+            a.emit32(offset);
+            ++pushed;
+            break;
+        case Bytecode::LOAD:
+            a.emit({ 0x50 }); // push rax
+            a.emit({ 0x41, 0x8B, 0x84, 0x24 }); // mov eax, [r12 + offset]
+            a.emit32(offset);
+            ++pushed;
+            break;
+        case Bytecode::STORE:
+            a.emit({ 0x41, 0x89, 0x84, 0x24 }); // mov [r12 + offset], eax
+            a.emit32(offset);
+            break;
+        case Bytecode::NEGATE:
+            a.emit({ 0xF7, 0xD8 }); // neg eax
+            break;
+        case Bytecode::FACTORIAL:
+            a.emit({ 0x89, 0xC7 }); // mov edi, eax
+            a.call(reinterpret_cast<const void*>(&factorial), pushed);
+            break;
+        case Bytecode::ADD:
+            a.emit({ 0x59 }); // pop rcx
+            a.emit({ 0x01, 0xC8 }); // add eax, ecx
+            --pushed;
+            break;
+        case Bytecode::SUBTRACT:
+            a.emit({ 0x59 }); // pop rcx
+            a.emit({ 0x29, 0xC1 }); // sub ecx, eax
+            a.emit({ 0x89, 0xC8 }); // mov eax, ecx
+            --pushed;
+            break;
+        case Bytecode::MULTIPLY:
+            a.emit({ 0x59 }); // pop rcx
+            a.emit({ 0x0F, 0xAF, 0xC1 }); // imul eax, ecx
+            --pushed;
+            break;
+        case Bytecode::DIVIDE:
+        case Bytecode::MODULUS:
+            a.emit({ 0x89, 0xC1 }); // mov ecx, eax
+            a.emit({ 0x85, 0xC9 }); // test ecx, ecx
+            a.jump_to_failure_if_zero();
+            a.emit({ 0x58 }); // pop rax
+            a.emit({ 0x99 }); // cdq
+            a.emit({ 0xF7, 0xF9 }); // idiv ecx
+            if (instruction.op == Bytecode::MODULUS)
+                a.emit({ 0x89, 0xD0 }); // mov eax, edx
+            --pushed;
+            break;
+        case Bytecode::POWER:
+            a.emit({ 0x89, 0xC6 }); // mov esi, eax
+            a.emit({ 0x5F }); // pop rdi
+            --pushed;
+            a.call(reinterpret_cast<const void*>(&power), pushed);
+            break;
+        case Bytecode::RETURN:
+            a.emit({ 0x48, 0x8B, 0x55, 0xE8 }); // mov rdx, [rbp - 24]
+            a.emit({ 0x89, 0x02 }); // mov [rdx], eax
+            a.emit({ 0xB8 }); // mov eax, 1
+            a.emit32(1);
+            a.epilogue();
+            break;
+        }
+    }
+
+    a.finish();
+    return a.code;
+}
+
+}
+
+// Ctor
+Native_Code::Native_Code(const Bytecode& bytecode)
+    : function(nullptr)
+    , memory(nullptr)
+    , length(0)
+    , context(bytecode.variables())
+    , temps(bytecode.temporaries())
+{
+#if NATIVE_CODE_SUPPORTED
+    if (bytecode.program().size() > max_instructions || bytecode.depth() > max_depth)
+        return;
+
+    std::vector<std::uint8_t> code = translate(bytecode);
+
+    void* page = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (page == MAP_FAILED)
+        return;
+
+    std::memcpy(page, code.data(), code.size());
+    if (mprotect(page, code.size(), PROT_READ | PROT_EXEC) != 0) {
+        munmap(page, code.size());
+        return;
+    }
+
+    memory = page;
+    length = code.size();
+    function = reinterpret_cast<Function>(page);
+#endif
+}
+
+// Dtor
+Native_Code::~Native_Code()
+{
+#if NATIVE_CODE_SUPPORTED
+    if (memory)
+        munmap(memory, length);
+#endif
+}
+
+bool Native_Code::valid() const
+{
+    return function != nullptr;
+}
+
+bool Native_Code::evaluate(int& result) const
+{
+    // most programs need few temporaries, so only big ones allocate
+    int small[64];
+    std::vector<int> large;
+    int* temporaries = small;
+    if (temps > 64) {
+        large.resize(temps);
+        temporaries = large.data();
+    }
+
+    // the slot array can move as variables are added, so read it now
+    return function(context ? context->data() : nullptr, temporaries, &result);
+}
+
+std::size_t Native_Code::size() const
+{
+    return length;
+}
@@ -0,0 +1,232 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#include "Optimization_Visitor.h"
+#include "Composite_Add_Node.h"
+#include "Composite_Divide_Node.h"
+#include "Composite_Factorial_Node.h"
+#include "Composite_Modulus_Node.h"
+#include "Composite_Multiply_Node.h"
+#include "Composite_Negate_Node.h"
+#include "Composite_Power_Node.h"
+#include "Composite_Subtract_Node.h"
+#include "Leaf_Node.h"
+#include "Variable_Node.h"
+#include <climits>
+#include <math.h>
+#include <unordered_map>
+#include <utility>
+
+// Ctor
+Optimization_Visitor::Optimization_Visitor(bool share)
+    : factory(share)
+{
+}
+
+Expression_Tree Optimization_Visitor::optimize(const Expression_Tree& tree)
+{
+    if (tree.is_null())
+        return tree;
+
+    // optimized form of every distinct node seen so far
+    std::unordered_map<const Component_Node*, Term> done;
+    // post-order walk; the flag is true once the node's children are
+    // on the stack ahead of it
+    std::vector<std::pair<const Component_Node*, bool>> pending { { tree.get_root(), false } };
+
+    while (!pending.empty()) {
+        auto [node, expanded] = pending.back();
+        pending.pop_back();
+
+        auto iter = done.find(node);
+        if (iter != done.end()) {
+            stack.push_back(iter->second);
+        } else if (!expanded) {
+            pending.emplace_back(node, true);
+            if (node->right())
+                pending.emplace_back(node->right(), false);
+            if (node->left())
+                pending.emplace_back(node->left(), false);
+        } else {
+            node->accept(*this);
+            done.emplace(node, stack.back());
+        }
+    }
+
+    Expression_Tree result(stack.back().node);
+    stack.clear();
+    factory.clear();
+    return result;
+}
+
+Optimization_Visitor::Term Optimization_Visitor::number(int value)
+{
+    return Term { factory.make_number(value), true, true, value, false, Node() };
+}
+
+Optimization_Visitor::Term Optimization_Visitor::term(const Node& node, bool leaf)
+{
+    return Term { node, false, leaf, 0, false, Node() };
+}
+
+Optimization_Visitor::Term Optimization_Visitor::pop()
+{
+    Term t = stack.back();
+    stack.pop_back();
+    return t;
+}
+
+bool Optimization_Visitor::is(const Term& t, int value)
+{
+    return t.constant && t.value == value;
+}
+
+void Optimization_Visitor::visit(const Leaf_Node& node)
+{
+    stack.push_back(number(node.item()));
+}
+
+void Optimization_Visitor::visit(const Variable_Node& node)
+{
+    stack.push_back(term(factory.make_variable(node.context(), node.slot()), true));
+}
+
+void Optimization_Visitor::visit(const Composite_Negate_Node&)
+{
+    Term operand = pop();
+
+    // constants are only folded when the result fits in an int, so
+    // the tree still overflows the same way when it's evaluated
+    int result;
+    if (operand.constant && !__builtin_sub_overflow(0, operand.value, &result)) {
+        stack.push_back(number(result));
+    } else if (operand.negation) {
+        // --x
+        stack.push_back(term(operand.negated));
+    } else {
+        Term t = term(factory.make_negate(operand.node));
+        t.negation = true;
+        t.negated = operand.node;
+        stack.push_back(t);
+    }
+}
+
+void Optimization_Visitor::visit(const Composite_Add_Node&)
+{
+    Term rhs = pop();
+    Term lhs = pop();
+
+    int result;
+    if (lhs.constant && rhs.constant && !__builtin_add_overflow(lhs.value, rhs.value, &result))
+        stack.push_back(number(result));
+    else if (is(rhs, 0))
+        stack.push_back(lhs);
+    else if (is(lhs, 0))
+        stack.push_back(rhs);
+    else
+        stack.push_back(term(factory.make_add(lhs.node, rhs.node)));
+}
+
+void Optimization_Visitor::visit(const Composite_Subtract_Node&)
+{
+    Term rhs = pop();
+    Term lhs = pop();
+
+    int result;
+    if (lhs.constant && rhs.constant && !__builtin_sub_overflow(lhs.value, rhs.value, &result))
+        stack.push_back(number(result));
+    else if (is(rhs, 0))
+        stack.push_back(lhs);
+    else
+        stack.push_back(term(factory.make_subtract(lhs.node, rhs.node)));
+}
+
+void Optimization_Visitor::visit(const Composite_Divide_Node&)
+{
+    Term rhs = pop();
+    Term lhs = pop();
+
+    // INT_MIN / -1 overflows
+    if (lhs.constant && rhs.constant && rhs.value != 0
+        && !(lhs.value == INT_MIN && rhs.value == -1))
+        stack.push_back(number(lhs.value / rhs.value));
+    else if (is(rhs, 1))
+        stack.push_back(lhs);
+    else
+        stack.push_back(term(factory.make_divide(lhs.node, rhs.node)));
+}
+
+void Optimization_Visitor::visit(const Composite_Multiply_Node&)
+{
+    Term rhs = pop();
+    Term lhs = pop();
+
+    int result;
+    if (lhs.constant && rhs.constant && !__builtin_mul_overflow(lhs.value, rhs.value, &result))
+        stack.push_back(number(result));
+    else if (is(rhs, 1))
+        stack.push_back(lhs);
+    else if (is(lhs, 1))
+        stack.push_back(rhs);
+    else
+        stack.push_back(term(factory.make_multiply(lhs.node, rhs.node)));
+}
+
+void Optimization_Visitor::visit(const Composite_Modulus_Node&)
+{
+    Term rhs = pop();
+    Term lhs = pop();
+
+    // INT_MIN % -1 traps like INT_MIN / -1
+    if (lhs.constant && rhs.constant && rhs.value != 0
+        && !(lhs.value == INT_MIN && rhs.value == -1))
+        stack.push_back(number(lhs.value % rhs.value));
+    else
+        stack.push_back(term(factory.make_modulus(lhs.node, rhs.node)));
+}
+
+void Optimization_Visitor::visit(const Composite_Power_Node&)
+{
+    Term rhs = pop();
+    Term lhs = pop();
+
+    double power = lhs.constant && rhs.constant ? pow(lhs.value, rhs.value) : 0;
+    if (lhs.constant && rhs.constant && power >= INT_MIN && power <= INT_MAX) {
+        // same conversion as Evaluation_Visitor
+        stack.push_back(number(static_cast<int>(power)));
+    } else if (is(rhs, 1)) {
+        stack.push_back(lhs);
+    } else if (rhs.constant && rhs.value >= 2 && rhs.value <= 4
+        && (lhs.leaf || factory.sharing())) {
+        // x^n becomes x*x*...*x. Only done for leaves, or when shared
+        // nodes are evaluated once, so the base isn't evaluated n times.
+        Node product = lhs.node;
+        for (int i = 1; i < rhs.value; ++i)
+            product = factory.make_multiply(product, lhs.node);
+        stack.push_back(term(product));
+    } else {
+        stack.push_back(term(factory.make_power(lhs.node, rhs.node)));
+    }
+}
+
+void Optimization_Visitor::visit(const Composite_Factorial_Node&)
+{
+    Term operand = pop();
+
+    int result = 1;
+    bool overflow = false;
+    if (operand.constant)
+        for (int i = operand.value; i > 1 && !overflow; --i)
+            overflow = __builtin_mul_overflow(result, i, &result);
+
+    if (operand.constant && !overflow) {
+        stack.push_back(number(result));
+    } else {
+        stack.push_back(term(factory.make_factorial(operand.node)));
+    }
+}
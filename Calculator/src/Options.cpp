@@ -4,6 +4,7 @@
 
 #include "Options.h"
 #include "getopt.h"
+#include <cstdlib>
 #include <iostream>
 
 // Initialize the singleton.
@@ -20,6 +21,18 @@ Options* Options::instance()
 // Ctor
 Options::Options()
     : isVerbose(false)
+    , cacheCapacity(256)
+    , shareSubtrees(false)
+    , isOptimized(false)
+    , useJit(false)
+    , useFlat(false)
+    , useThreaded(false)
+    , isParallel(false)
+    , jobThreads(0)
+    , forkJoin(false)
+    , forkJoinThreads(0)
+    , reactorCount(1)
+    , useFrames(false)
 {
 }
 
@@ -40,13 +53,97 @@ bool Options::verbose() const
     return isVerbose;
 }
 
+// Return the expression cache capacity.
+std::size_t Options::cache_capacity() const
+{
+    return cacheCapacity;
+}
+
+// Return whether identical subexpressions are shared.
+bool Options::share_subtrees() const
+{
+    return shareSubtrees;
+}
+
+// Return whether expressions are optimized.
+bool Options::optimize() const
+{
+    return isOptimized;
+}
+
+// Return whether expressions are translated to machine code.
+bool Options::jit() const
+{
+    return useJit;
+}
+
+// Return whether expressions are printed and evaluated as flat arrays.
+bool Options::flat() const
+{
+    return useFlat;
+}
+
+// Return whether trees are walked through parent links.
+bool Options::threaded() const
+{
+    return useThreaded;
+}
+
+// Return the expression to evaluate in batch mode.
+std::string Options::batch() const
+{
+    return batchExpression;
+}
+
+// Return whether jobs are evaluated in parallel.
+bool Options::parallel() const
+{
+    return isParallel;
+}
+
+// Return whether large expressions are evaluated on several threads.
+bool Options::fork_join() const
+{
+    return forkJoin;
+}
+
+// Return the number of threads for parallel jobs.
+std::size_t Options::job_threads() const
+{
+    return jobThreads;
+}
+
+// Return the number of threads for fork-join evaluation.
+std::size_t Options::fork_join_threads() const
+{
+    return forkJoinThreads;
+}
+
+// Return the address to serve commands on.
+std::string Options::serve() const
+{
+    return serveAddress;
+}
+
+// Return the number of event loops that serve clients.
+std::size_t Options::reactors() const
+{
+    return reactorCount;
+}
+
+// Return whether clients send their commands in frames.
+bool Options::framed() const
+{
+    return useFrames;
+}
+
 // Parse the command line arguments.
 bool Options::parse_args(int argc, char* argv[])
 {
     // set exe_ to the first arg.
     execStr = parsing::getfilename(argv[0]);
     pathStr = parsing::getpath(argv[0]);
-    char opts[] = "h?v";
+    char opts[] = "h?vsojltFc:b:p:f:S:r:";
 
     for (int c; (c = parsing::getopt(argc, argv, opts)) != EOF;)
         switch (c) {
@@ -54,6 +151,44 @@ bool Options::parse_args(int argc, char* argv[])
         case 'v':
             isVerbose = true;
             break;
+        case 's':
+            shareSubtrees = true;
+            break;
+        case 'o':
+            isOptimized = true;
+            break;
+        case 'j':
+            useJit = true;
+            break;
+        case 'l':
+            useFlat = true;
+            break;
+        case 't':
+            useThreaded = true;
+            break;
+        case 'c':
+            cacheCapacity = std::strtoul(parsing::optarg, nullptr, 10);
+            break;
+        case 'b':
+            batchExpression = parsing::optarg;
+            break;
+        case 'p':
+            isParallel = true;
+            jobThreads = std::strtoul(parsing::optarg, nullptr, 10);
+            break;
+        case 'f':
+            forkJoin = true;
+            forkJoinThreads = std::strtoul(parsing::optarg, nullptr, 10);
+            break;
+        case 'S':
+            serveAddress = parsing::optarg;
+            break;
+        case 'r':
+            reactorCount = std::strtoul(parsing::optarg, nullptr, 10);
+            break;
+        case 'F':
+            useFrames = true;
+            break;
         case 'h':
         case '?':
             print_usage();
@@ -69,10 +204,38 @@ bool Options::parse_args(int argc, char* argv[])
 void Options::print_usage()
 {
     std::cout << std::endl << "Help Invoked on " << pathStr + execStr << std::endl << std::endl;
-    std::cout << "Usage: " << execStr << " [-h|-v]" << std::endl
+    std::cout << "Usage: " << execStr << " [-h|-v|-s|-o|-j|-l|-t|-F] [-c capacity] [-b expression] [-p threads] [-f threads] [-S address] [-r reactors]" << std::endl
               << std::endl
               << "  -h: invoke help" << std::endl
               << "  -v: enter verbose mode" << std::endl
+              << "  -s: share repeated subexpressions" << std::endl
+              << "  -o: fold constants and simplify expressions" << std::endl
+              << "  -j: evaluate with machine code (x86-64 Linux)" << std::endl
+              << "  -l: print and evaluate expressions stored as flat arrays" << std::endl
+              << "  -t: walk trees through parent links instead of a stack" << std::endl
+              << "  -c: number of parsed expressions to cache (default 256, 0 = off)"
+              << std::endl
+              << "  -b: evaluate the expression for every row of a table on standard input;"
+              << std::endl
+              << "      the first line names the variables, one column each" << std::endl
+              << "  -p: evaluate jobs from standard input on this many threads (0 = one per"
+              << std::endl
+              << "      core); each line is an expression, then ';' and name=value bindings"
+              << std::endl
+              << "  -f: split the evaluation of very large expressions across this many"
+              << std::endl
+              << "      threads (0 = one per core)" << std::endl
+              << "  -S: serve commands to clients on a Unix socket path or a loopback"
+              << std::endl
+              << "      [host:]port, one session per connection; the host must be in"
+              << std::endl
+              << "      127.0.0.0/8 (default 127.0.0.1)" << std::endl
+              << "  -r: serve clients on this many event loops, each on a thread pinned to"
+              << std::endl
+              << "      a core (default 1, 0 = one per core)" << std::endl
+              << "  -F: clients send batches of commands in length-prefixed frames and get"
+              << std::endl
+              << "      one frame of results back per batch" << std::endl
               << std::endl;
 }
 
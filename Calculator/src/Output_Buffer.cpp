@@ -0,0 +1,58 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#include "Output_Buffer.h"
+#include <algorithm>
+#include <cstring>
+
+// Room for the first output.
+static const std::size_t INITIAL_SIZE = 4096;
+
+Output_Buffer::Output_Buffer()
+{
+    setp(nullptr, nullptr);
+}
+
+const char* Output_Buffer::data() const
+{
+    return pbase();
+}
+
+std::size_t Output_Buffer::size() const
+{
+    return pptr() - pbase();
+}
+
+void Output_Buffer::consume(std::size_t count)
+{
+    std::size_t left = size() - std::min(count, size());
+    if (left > 0)
+        std::memmove(pbase(), pptr() - left, left);
+    setp(pbase(), epptr());
+    pbump(static_cast<int>(left));
+}
+
+void Output_Buffer::replace(std::size_t offset, const char* bytes, std::size_t count)
+{
+    if (offset + count <= size())
+        std::memcpy(pbase() + offset, bytes, count);
+}
+
+Output_Buffer::int_type Output_Buffer::overflow(int_type ch)
+{
+    std::size_t used = size();
+    storage.resize(std::max(INITIAL_SIZE, 2 * storage.size()));
+    setp(&storage[0], &storage[0] + storage.size());
+    pbump(static_cast<int>(used));
+
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
@@ -0,0 +1,252 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#include "Parallel_Evaluator.h"
+#include "AStack.h"
+#include "Component_Node.h"
+#include "Leaf_Node.h"
+#include "Thread_Pool.h"
+#include "Variable_Node.h"
+#include "Visitor.h"
+#include <atomic>
+#include <math.h>
+#include <thread>
+#include <utility>
+
+/**
+ * @class Subtree_Evaluator
+ * @brief Visitor that evaluates nodes visited in post-order on a stack
+ *        of values.  Division or modulus by zero stops it instead of
+ *        printing, so the caller can give up on the whole tree.
+ */
+class Subtree_Evaluator : public Visitor {
+public:
+    Subtree_Evaluator()
+        : failed(false)
+    {
+    }
+
+    // Evaluate the subtree rooted at @a root into @a result.
+    bool evaluate(const Component_Node* root, int& result)
+    {
+        // a leaf doesn't need a walk
+        if (!root->left() && !root->right()) {
+            result = root->item();
+            return true;
+        }
+
+        values.erase();
+        pending.erase();
+        pending.emplace(root, false);
+        while (!pending.is_empty()) {
+            auto [node, expanded] = pending.pop();
+            if (!expanded) {
+                pending.emplace(node, true);
+                if (node->right())
+                    pending.emplace(node->right(), false);
+                if (node->left())
+                    pending.emplace(node->left(), false);
+            } else if (!apply(node)) {
+                return false;
+            }
+        }
+        result = pop();
+        return true;
+    }
+
+    // Apply the operator of @a node to the values already pushed for
+    // its children.
+    bool apply(const Component_Node* node)
+    {
+        node->accept(*this);
+        if (failed) {
+            failed = false;
+            return false;
+        }
+        return true;
+    }
+
+    // Push a value that has already been evaluated.
+    void push(int value)
+    {
+        values.push(value);
+    }
+
+    // Remove and return the value on top of the stack.
+    int pop()
+    {
+        return values.pop();
+    }
+
+    void visit(const Leaf_Node& node) override
+    {
+        values.push(node.item());
+    }
+
+    void visit(const Variable_Node& node) override
+    {
+        values.push(node.item());
+    }
+
+    void visit(const Composite_Negate_Node&) override
+    {
+        values.top() = -values.top();
+    }
+
+    void visit(const Composite_Factorial_Node&) override
+    {
+        int factorial = 1;
+        for (int i = values.top(); i > 1; --i)
+            factorial *= i;
+        values.top() = factorial;
+    }
+
+    void visit(const Composite_Add_Node&) override
+    {
+        int rhs = pop();
+        values.top() += rhs;
+    }
+
+    void visit(const Composite_Subtract_Node&) override
+    {
+        int rhs = pop();
+        values.top() -= rhs;
+    }
+
+    void visit(const Composite_Multiply_Node&) override
+    {
+        int rhs = pop();
+        values.top() *= rhs;
+    }
+
+    void visit(const Composite_Divide_Node&) override
+    {
+        int rhs = pop();
+        if (rhs == 0)
+            failed = true;
+        else
+            values.top() /= rhs;
+    }
+
+    void visit(const Composite_Modulus_Node&) override
+    {
+        int rhs = pop();
+        if (rhs == 0)
+            failed = true;
+        else
+            values.top() %= rhs;
+    }
+
+    void visit(const Composite_Power_Node&) override
+    {
+        int rhs = pop();
+        // same conversion as Evaluation_Visitor
+        values.top() = static_cast<int>(pow(values.top(), rhs));
+    }
+
+private:
+    AStack<int> values;
+    AStack<std::pair<const Component_Node*, bool>> pending;
+    bool failed;
+};
+
+Parallel_Evaluator::Parallel_Evaluator(Thread_Pool& pool, std::size_t threshold)
+    : pool(pool)
+    , threshold(threshold < 2 ? 2 : threshold)
+{
+}
+
+bool Parallel_Evaluator::evaluate(const Component_Node* root, int& result) const
+{
+    /**
+     * @struct Pending
+     * @brief A node on the way down whose big child is still being
+     *        evaluated, and the value of its small child if it has one.
+     */
+    struct Pending {
+        const Component_Node* node;
+        int operand;
+        // NONE if the node has one child, otherwise the side the
+        // operand belongs to
+        enum { NONE, LEFT, RIGHT } side;
+    };
+
+    Subtree_Evaluator evaluator;
+    // Walk down while only one child is big, so long chains are a loop
+    // here instead of a recursion.
+    AStack<Pending> spine;
+    const Component_Node* node = root;
+    int value;
+
+    for (;;) {
+        if (node->size() < threshold) {
+            if (!evaluator.evaluate(node, value))
+                return false;
+            break;
+        }
+
+        const Component_Node* left = node->left();
+        const Component_Node* right = node->right();
+        if (!left || !right) {
+            spine.push({ node, 0, Pending::NONE });
+            node = left ? left : right;
+            continue;
+        }
+
+        bool left_big = left->size() >= threshold;
+        bool right_big = right->size() >= threshold;
+        if (left_big && right_big) {
+            // fork the left subtree, evaluate the right one here, then join
+            struct {
+                int value;
+                bool ok;
+                std::atomic<bool> done;
+            } forked { 0, false, { false } };
+            pool.submit([this, left, &forked] {
+                forked.ok = evaluate(left, forked.value);
+                forked.done.store(true, std::memory_order_release);
+            });
+            int right_value;
+            bool right_ok = evaluate(right, right_value);
+            while (!forked.done.load(std::memory_order_acquire)) {
+                if (!pool.run_one())
+                    std::this_thread::yield();
+            }
+            if (!forked.ok || !right_ok)
+                return false;
+            evaluator.push(forked.value);
+            evaluator.push(right_value);
+            if (!evaluator.apply(node))
+                return false;
+            value = evaluator.pop();
+            break;
+        }
+
+        int operand;
+        if (!evaluator.evaluate(left_big ? right : left, operand))
+            return false;
+        spine.push({ node, operand, left_big ? Pending::RIGHT : Pending::LEFT });
+        node = left_big ? left : right;
+    }
+
+    // apply the operators on the way back up
+    while (!spine.is_empty()) {
+        Pending pending = spine.pop();
+        if (pending.side == Pending::LEFT)
+            evaluator.push(pending.operand);
+        evaluator.push(value);
+        if (pending.side == Pending::RIGHT)
+            evaluator.push(pending.operand);
+        if (!evaluator.apply(pending.node))
+            return false;
+        value = evaluator.pop();
+    }
+
+    result = value;
+    return true;
+}
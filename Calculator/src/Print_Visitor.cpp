@@ -12,61 +12,73 @@
 #include "Composite_Power_Node.h"
 #include "Composite_Subtract_Node.h"
 #include "Leaf_Node.h"
+#include "Variable_Node.h"
 #include <iostream>
 #include <memory>
 
+Print_Visitor::Print_Visitor(std::ostream& out)
+    : out(out)
+{
+}
+
 // visit function - prints Leaf_Negate_Node contents to std::cout
 void Print_Visitor::visit(const Leaf_Node& node)
 {
-    std::cout << " " << node.item();
+    out << " " << node.item();
+}
+
+// visit function - prints the current value of a Variable_Node to std::cout
+void Print_Visitor::visit(const Variable_Node& node)
+{
+    out << " " << node.item();
 }
 
 // visit function - prints Composite_Negate_Node contents to std::cout
 void Print_Visitor::visit(const Composite_Negate_Node&)
 {
-    std::cout << '-';
+    out << '-';
 }
 
 // visit function - prints Composite_Add_Node contents to std::cout
 void Print_Visitor::visit(const Composite_Add_Node&)
 {
-    std::cout << " +";
+    out << " +";
 }
 
 // visit function - prints Composite_Subtract_Node contents to std::cout
 void Print_Visitor::visit(const Composite_Subtract_Node&)
 {
-    std::cout << " -";
+    out << " -";
 }
 
 // visit function - prints Composite_Divide_Node contents to std::cout
 void Print_Visitor::visit(const Composite_Divide_Node&)
 {
-    std::cout << " /";
+    out << " /";
 }
 
 // visit function - prints Composite_Multiply_Node contents to std::cout
 void Print_Visitor::visit(const Composite_Multiply_Node&)
 {
-    std::cout << " *";
+    out << " *";
 }
 
 // visit function - prints Composite_Modulus_Node contents to std::cout
-void Print_Visitor::visit(const Composite_Modulus_Node& node)
+void Print_Visitor::visit(const Composite_Modulus_Node&)
 {
-    std::cout << " %";
+    out << " %";
 }
 
 // visit function - prints Composite_Power_Node contents to std::cout
-void Print_Visitor::visit(const Composite_Power_Node& node)
+void Print_Visitor::visit(const Composite_Power_Node&)
 {
-    std::cout << "^";
+    out << "^";
 }
 
 // visit function - prints Composite_Factorial_Node contents to std::cout
-void Print_Visitor::visit(const Composite_Factorial_Node& node)
+void Print_Visitor::visit(const Composite_Factorial_Node&)
 {
-    std::cout << "!";
+    out << "!";
 }
 
 #endif // PRINT_VISITOR_CPP
@@ -5,34 +5,57 @@
 #include "Reactor.h"
 #include "Event_Handler.h"
 #include <algorithm>
-#include <functional>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
 
-Reactor* Reactor::inst = nullptr;
+thread_local Reactor* Reactor::inst = nullptr;
+
+// Resolution of the timer wheel and its number of slots.
+static const std::chrono::milliseconds TIMER_TICK(10);
+static const std::size_t TIMER_SLOTS = 256;
+
+// Most events taken from the epoll set per wait.
+static const int MAX_EVENTS = 256;
 
 Reactor::Reactor()
-    : running_event_loop(true)
+    : epoll_handle(epoll_create1(EPOLL_CLOEXEC))
+    , events(MAX_EVENTS)
+    , event_count(0)
+    , next_event(0)
+    , wheel(TIMER_SLOTS, nullptr)
+    , start(std::chrono::steady_clock::now())
+    , now(0)
+    , next_timer_id(1)
+    , next_serial(1)
+    , running_event_loop(true)
 {
+    if (epoll_handle < 0)
+        throw std::domain_error(std::string("Can't create the epoll set: ") + std::strerror(errno));
 }
 
-/**
- * @class Remove_Handler_Adapter
- * @brief This functor implements the Adapter pattern so an @a
- *        Reactor's remove_input_handler() method can be called
- *        with the appropriate Event_Handler in the context of the
- *        std:for_each() algorithm.
- */
-struct Remove_Handler_Adapter {
-    // Remote event_handler from the singleton Reactor.
-    bool operator()(Event_Handler* event_handler)
-    {
-        Reactor::instance()->remove_input_handler(event_handler);
-        return true;
-    }
-};
-
 Reactor::~Reactor()
 {
-    std::for_each(dispatch_table.begin(), dispatch_table.end(), Remove_Handler_Adapter());
+    std::vector<Event_Handler*> handlers;
+    for (const auto& entry : dispatch_table)
+        handlers.push_back(entry.first);
+    for (Event_Handler* event_handler : handlers)
+        remove_input_handler(event_handler);
+    delete_closed_handlers();
+
+    for (Timer* slot : wheel) {
+        while (slot) {
+            Timer* timer = slot;
+            slot = slot->next;
+            delete timer;
+        }
+    }
+    close(epoll_handle);
+    if (inst == this)
+        inst = nullptr;
 }
 
 Reactor* Reactor::instance()
@@ -44,21 +67,202 @@ Reactor* Reactor::instance()
 
 void Reactor::register_input_handler(Event_Handler* eh)
 {
-    dispatch_table.push_back(eh);
+    Registration registration { eh->get_handle(), 0, false, next_serial++ };
+
+    if (registration.handle >= 0) {
+        registration.flags = fcntl(registration.handle, F_GETFL);
+        if (registration.flags < 0)
+            throw std::domain_error(std::string("Bad handle: ") + std::strerror(errno));
+
+        epoll_event event {};
+        event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        event.data.ptr = eh;
+        if (epoll_ctl(epoll_handle, EPOLL_CTL_ADD, registration.handle, &event) == 0) {
+            // edge-triggered handlers read until the handle would block
+            registration.polled = true;
+            if (!(registration.flags & O_NONBLOCK))
+                fcntl(registration.handle, F_SETFL, registration.flags | O_NONBLOCK);
+        } else if (errno == EPERM) {
+            // regular files never block, so they're always ready
+            ready_handlers.push_back(eh);
+        } else {
+            throw std::domain_error(std::string("Can't wait on handle: ") + std::strerror(errno));
+        }
+    }
+
+    dispatch_table[eh] = registration;
+    eh->handle_open();
 }
 
 void Reactor::remove_input_handler(Event_Handler* eh)
 {
-    auto iter = std::remove(dispatch_table.begin(), dispatch_table.end(), eh);
-    dispatch_table.erase(iter);
-    delete eh;
+    auto entry = dispatch_table.find(eh);
+    if (entry == dispatch_table.end())
+        return;
+    const Registration& registration = entry->second;
+
+    if (registration.polled) {
+        epoll_ctl(epoll_handle, EPOLL_CTL_DEL, registration.handle, nullptr);
+        if (!(registration.flags & O_NONBLOCK))
+            fcntl(registration.handle, F_SETFL, registration.flags);
+    }
+    ready_handlers.erase(
+        std::remove(ready_handlers.begin(), ready_handlers.end(), eh), ready_handlers.end());
+
+    // forget events for the handler that haven't been dispatched yet
+    for (int i = next_event; i < event_count; ++i)
+        if (events[i].data.ptr == eh)
+            events[i].data.ptr = nullptr;
+
+    // its timers expire unseen, since the serial no longer matches
+    dispatch_table.erase(entry);
+    closed_handlers.push_back(eh);
+}
+
+long Reactor::schedule_timer(Event_Handler* eh, std::chrono::milliseconds delay,
+    std::chrono::milliseconds interval)
+{
+    auto entry = dispatch_table.find(eh);
+    if (entry == dispatch_table.end())
+        throw std::domain_error("Timer for an unregistered handler");
+
+    // the wheel stands still while it has no timers
+    std::size_t tick = current_tick();
+    if (timers.empty())
+        now = tick;
+
+    auto ticks = [](std::chrono::milliseconds time) {
+        long long count = (time.count() + TIMER_TICK.count() - 1) / TIMER_TICK.count();
+        return static_cast<std::size_t>(std::max(1LL, count));
+    };
+    Timer* timer = new Timer { next_timer_id++, eh, entry->second.serial, 0,
+        interval.count() > 0 ? ticks(interval) : 0, nullptr };
+    place(timer, ticks(delay) + (tick - now));
+    timers[timer->id] = timer;
+    return timer->id;
+}
+
+bool Reactor::cancel_timer(long timer_id)
+{
+    auto entry = timers.find(timer_id);
+    if (entry == timers.end())
+        return false;
+
+    // the wheel frees the timer when it comes around
+    entry->second->handler = nullptr;
+    timers.erase(entry);
+    return true;
+}
+
+void Reactor::place(Timer* timer, std::size_t ticks)
+{
+    Timer*& slot = wheel[(now + ticks) % TIMER_SLOTS];
+    timer->rounds = (ticks - 1) / TIMER_SLOTS;
+    timer->next = slot;
+    slot = timer;
+}
+
+void Reactor::expire_timers()
+{
+    std::size_t tick = current_tick();
+
+    while (now < tick && !timers.empty()) {
+        ++now;
+        Timer*& slot = wheel[now % TIMER_SLOTS];
+        Timer* expiring = slot;
+        slot = nullptr;
+
+        while (expiring) {
+            Timer* timer = expiring;
+            expiring = expiring->next;
+
+            if (timer->handler && timer->rounds > 0) {
+                --timer->rounds;
+                timer->next = slot;
+                slot = timer;
+                continue;
+            }
+
+            Event_Handler* eh = timer->handler;
+            long id = timer->id;
+            auto entry = eh ? dispatch_table.find(eh) : dispatch_table.end();
+            bool live = entry != dispatch_table.end() && entry->second.serial == timer->serial;
+
+            if (live && timer->interval > 0) {
+                place(timer, timer->interval);
+            } else {
+                if (eh)
+                    timers.erase(id);
+                delete timer;
+            }
+            if (live)
+                eh->handle_timeout(id);
+        }
+    }
+
+    // only cancelled timers are left, which don't need the ticks
+    now = tick;
+}
+
+std::size_t Reactor::current_tick() const
+{
+    return (std::chrono::steady_clock::now() - start) / TIMER_TICK;
+}
+
+int Reactor::wait_time() const
+{
+    if (!ready_handlers.empty())
+        return 0;
+    if (timers.empty())
+        return -1;
+
+    // sleep until the next slot that has timers
+    std::size_t tick = now + 1;
+    while (!wheel[tick % TIMER_SLOTS] && tick < now + TIMER_SLOTS)
+        ++tick;
+    auto due = start + TIMER_TICK * static_cast<std::chrono::milliseconds::rep>(tick);
+    auto left = std::chrono::ceil<std::chrono::milliseconds>(due - std::chrono::steady_clock::now());
+    return std::max<int>(0, static_cast<int>(left.count()));
+}
+
+void Reactor::delete_closed_handlers()
+{
+    for (Event_Handler* eh : closed_handlers)
+        delete eh;
+    closed_handlers.clear();
 }
 
 void Reactor::run_event_loop()
 {
-    while (running_event_loop)
-        std::for_each(dispatch_table.begin(), dispatch_table.end(),
-            std::mem_fn(&Event_Handler::handle_input));
+    while (running_event_loop) {
+        event_count = epoll_wait(epoll_handle, events.data(), MAX_EVENTS, wait_time());
+        if (event_count < 0) {
+            event_count = 0;
+            if (errno == EINTR)
+                continue;
+            throw std::domain_error(std::string("Can't wait for events: ") + std::strerror(errno));
+        }
+
+        // errors and hang-ups are dispatched as input, so the handler
+        // sees them when it reads.  A handler that removes itself has
+        // its event cleared.
+        for (next_event = 0; next_event < event_count; ++next_event) {
+            const epoll_event& event = events[next_event];
+            if (event.data.ptr && (event.events & ~EPOLLOUT))
+                static_cast<Event_Handler*>(event.data.ptr)->handle_input();
+            if (event.data.ptr && (event.events & EPOLLOUT))
+                static_cast<Event_Handler*>(event.data.ptr)->handle_output();
+        }
+        event_count = next_event = 0;
+
+        std::vector<Event_Handler*> ready(ready_handlers);
+        for (Event_Handler* eh : ready)
+            if (dispatch_table.count(eh))
+                eh->handle_input();
+
+        expire_timers();
+        delete_closed_handlers();
+    }
 }
 
 void Reactor::end_event_loop()
@@ -3,6 +3,30 @@
 #define REFCOUNTER_CPP
 
 #include "Refcounter.h"
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace refcounter_detail {
+// Overloads that tell whether a type derives from some Refcounted.
+template <bool ATOMIC> std::true_type is_refcounted(const Refcounted<ATOMIC>*);
+std::false_type is_refcounted(...);
+}
+
+template <typename T> constexpr bool Refcounter<T>::intrusive()
+{
+    return decltype(refcounter_detail::is_refcounted(static_cast<T*>(nullptr)))::value;
+}
+
+template <typename T> T* Refcounter<T>::object() const
+{
+    return static_cast<T*>(ptr);
+}
+
+template <typename T> typename Refcounter<T>::Shim* Refcounter<T>::shim() const
+{
+    return static_cast<Shim*>(ptr);
+}
 
 // default Ctor
 template <typename T>
@@ -14,10 +38,16 @@ Refcounter<T>::Refcounter()
 // Ctor with refcounting functionality
 template <typename T>
 Refcounter<T>::Refcounter(T* ptr, bool increase_count)
-    : ptr(new Shim(ptr))
+    : ptr(nullptr)
 {
-    if (increase_count)
+    if constexpr (intrusive()) {
+        this->ptr = ptr;
         increment();
+    } else {
+        this->ptr = new Shim(ptr);
+        if (increase_count)
+            increment();
+    }
 }
 
 // copy Ctor
@@ -28,6 +58,14 @@ Refcounter<T>::Refcounter(const Refcounter& rhs)
     increment();
 }
 
+// move Ctor
+template <typename T>
+Refcounter<T>::Refcounter(Refcounter&& rhs) noexcept
+    : ptr(rhs.ptr)
+{
+    rhs.ptr = nullptr;
+}
+
 // Dtor will delete pointer if refcount becomes 0
 template <typename T> Refcounter<T>::~Refcounter()
 {
@@ -38,73 +76,122 @@ template <typename T> Refcounter<T>::~Refcounter()
 // increased for incoming ptr.
 template <typename T> void Refcounter<T>::operator=(T* ptr)
 {
-    decrement();
-    ptr = new Shim(ptr);
+    Refcounter<T> wrapped(ptr);
+    *this = std::move(wrapped);
 }
 
 // assignment operator
 template <typename T> void Refcounter<T>::operator=(const Refcounter& rhs)
 {
-    decrement();
-    ptr = rhs.ptr;
-    increment();
+    // copy first, in case both refer to the same object
+    Refcounter<T> copy(rhs);
+    *this = std::move(copy);
+}
+
+// move assignment operator
+template <typename T> void Refcounter<T>::operator=(Refcounter&& rhs) noexcept
+{
+    if (this != &rhs) {
+        decrement();
+        ptr = rhs.ptr;
+        rhs.ptr = nullptr;
+    }
 }
 
 // get the underlying pointer
 template <typename T> T* Refcounter<T>::get_ptr()
 {
-    return ptr->t;
+    if constexpr (intrusive())
+        return object();
+    else
+        return ptr ? shim()->t : nullptr;
 }
 
 // get the underlying pointer
 template <typename T> const T* Refcounter<T>::get_ptr() const
 {
-    return ptr->t;
+    if constexpr (intrusive())
+        return object();
+    else
+        return ptr ? shim()->t : nullptr;
 }
 
 // dereference operator
 template <typename T> T& Refcounter<T>::operator*()
 {
-    return *ptr->t;
+    return *get_ptr();
 }
 
 // dereference operator
 template <typename T> const T& Refcounter<T>::operator*() const
 {
-    return *ptr->t;
+    return *get_ptr();
 }
 
 // mimic pointer dereferencing
 template <typename T> T* Refcounter<T>::operator->()
 {
-    return ptr->t;
+    return get_ptr();
 }
 
 // mimic pointer dereferencing
 template <typename T> const T* Refcounter<T>::operator->() const
 {
-    return ptr->t;
+    return get_ptr();
 }
 
 // implementation of the increment operation
 template <typename T> void Refcounter<T>::increment()
 {
-    if (ptr)
-        ++ptr->refcount;
+    if (!ptr)
+        return;
+    if constexpr (intrusive())
+        object()->add_reference();
+    else
+        ++shim()->refcount;
 }
 
 // implementation of the decrement operation
 template <typename T> void Refcounter<T>::decrement()
 {
-    if (ptr) {
-        --ptr->refcount;
-        if (ptr->refcount <= 0) {
-            delete ptr;
+    if (!ptr)
+        return;
+    if constexpr (intrusive()) {
+        if (object()->release_reference())
+            dispose(object());
+        ptr = nullptr;
+    } else {
+        --shim()->refcount;
+        if (shim()->refcount <= 0) {
+            dispose(shim());
             ptr = nullptr;
         }
     }
 }
 
+// delete an object whose last reference is gone
+template <typename T> template <typename U> void Refcounter<T>::dispose(U* doomed)
+{
+    // Deleting an object drops the references it holds, which may
+    // dispose of more objects.  Those are queued on this thread and
+    // deleted by the outermost call, so freeing a long chain doesn't
+    // recurse once per link.
+    static thread_local std::vector<U*>* pending = nullptr;
+    if (pending) {
+        pending->push_back(doomed);
+        return;
+    }
+    std::vector<U*> queue;
+    pending = &queue;
+    delete doomed;
+    while (!queue.empty()) {
+        doomed = queue.back();
+        queue.pop_back();
+        delete doomed;
+    }
+    pending = nullptr;
+}
+
 template <typename T>
 Refcounter<T>::Shim::Shim(T* t)
     : t(t)
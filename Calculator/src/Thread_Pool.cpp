@@ -0,0 +1,169 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#include "Thread_Pool.h"
+#include <algorithm>
+
+namespace {
+// Pool and index of the worker running on this thread.
+thread_local const Thread_Pool* current_pool = nullptr;
+thread_local int current_worker = -1;
+}
+
+Thread_Pool::Thread_Pool(std::size_t threads)
+    : queued(0)
+    , unfinished(0)
+    , next(0)
+    , stopping(false)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers.emplace_back(new Worker);
+        workers.back()->statistics = Statistics { 0, 0, std::chrono::nanoseconds(0) };
+    }
+    // every worker exists before any of them looks for work to steal
+    for (std::size_t i = 0; i < threads; ++i)
+        workers[i]->thread = std::thread(&Thread_Pool::run, this, i);
+}
+
+Thread_Pool::~Thread_Pool()
+{
+    wait();
+    {
+        std::lock_guard<std::mutex> guard(state_lock);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for (auto& worker : workers)
+        worker->thread.join();
+}
+
+void Thread_Pool::submit(Task task)
+{
+    int index = worker();
+    if (index < 0)
+        index = static_cast<int>(next++ % workers.size());
+
+    unfinished++;
+    {
+        std::lock_guard<std::mutex> guard(workers[index]->lock);
+        workers[index]->tasks.push_back(std::move(task));
+    }
+    {
+        // counted under the lock so a worker can't miss it and sleep
+        std::lock_guard<std::mutex> guard(state_lock);
+        queued++;
+    }
+    work_ready.notify_one();
+}
+
+void Thread_Pool::wait()
+{
+    std::unique_lock<std::mutex> guard(state_lock);
+    all_done.wait(guard, [this] { return unfinished == 0; });
+}
+
+std::size_t Thread_Pool::size() const
+{
+    return workers.size();
+}
+
+int Thread_Pool::worker() const
+{
+    return current_pool == this ? current_worker : -1;
+}
+
+bool Thread_Pool::run_one()
+{
+    Task task;
+    int index = worker();
+    if (!take(index, task))
+        return false;
+    execute(index, task);
+    return true;
+}
+
+Thread_Pool::Statistics Thread_Pool::statistics(std::size_t index) const
+{
+    std::lock_guard<std::mutex> guard(workers[index]->lock);
+    return workers[index]->statistics;
+}
+
+bool Thread_Pool::take(int index, Task& task)
+{
+    if (index >= 0) {
+        Worker& self = *workers[index];
+        std::lock_guard<std::mutex> guard(self.lock);
+        if (!self.tasks.empty()) {
+            task = std::move(self.tasks.back());
+            self.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // steal from the others, starting with the next worker
+    const std::size_t start = static_cast<std::size_t>(index + 1);
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        std::size_t victim_index = (start + i) % workers.size();
+        if (static_cast<int>(victim_index) == index)
+            continue;
+        Worker& victim = *workers[victim_index];
+        {
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (victim.tasks.empty())
+                continue;
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+        // only one deque is ever locked at a time
+        if (index >= 0) {
+            std::lock_guard<std::mutex> guard(workers[index]->lock);
+            workers[index]->statistics.stolen++;
+        }
+        return true;
+    }
+    return false;
+}
+
+void Thread_Pool::execute(int index, Task& task)
+{
+    queued--;
+    auto start = std::chrono::steady_clock::now();
+    task();
+    auto busy = std::chrono::steady_clock::now() - start;
+    if (index >= 0) {
+        std::lock_guard<std::mutex> guard(workers[index]->lock);
+        workers[index]->statistics.executed++;
+        workers[index]->statistics.busy += busy;
+    }
+    if (--unfinished == 0) {
+        std::lock_guard<std::mutex> guard(state_lock);
+        all_done.notify_all();
+    }
+}
+
+void Thread_Pool::run(std::size_t index)
+{
+    current_pool = this;
+    current_worker = static_cast<int>(index);
+
+    for (;;) {
+        Task task;
+        if (take(current_worker, task)) {
+            execute(current_worker, task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(state_lock);
+        work_ready.wait(guard, [this] { return queued > 0 || stopping; });
+        if (stopping && queued == 0)
+            return;
+    }
+}
@@ -0,0 +1,69 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#include "Tokenizer.h"
+#include "Interpreter.h"
+#include <charconv>
+#include <stdexcept>
+#include <system_error>
+
+// Ctor
+Tokenizer::Tokenizer(std::string_view input)
+    : input(input)
+    , pos(0)
+{
+}
+
+// Return the next token
+Tokenizer::Token Tokenizer::next()
+{
+    // skip whitespace
+    while (pos < input.length() && (input[pos] == ' ' || input[pos] == '\n'))
+        ++pos;
+
+    if (pos == input.length())
+        return Token { END, input.substr(pos) };
+
+    auto start = pos;
+    char c = input[pos++];
+    Kind kind;
+
+    if (Interpreter::is_number(c)) {
+        // merge all consecutive number chars into a single number,
+        // eg '123' = int (123)
+        while (pos < input.length() && Interpreter::is_number(input[pos]))
+            ++pos;
+        kind = NUMBER;
+    } else if (Interpreter::is_alphanumeric(c)) {
+        // merge all consecutive alphanumeric chars into a single
+        // variable name, eg 'abc'
+        while (pos < input.length() && Interpreter::is_alphanumeric(input[pos]))
+            ++pos;
+        kind = VARIABLE;
+    } else if (Interpreter::is_operator(c)) {
+        kind = OPERATOR;
+    } else if (c == '(') {
+        kind = LEFT_PAREN;
+    } else if (c == ')') {
+        kind = RIGHT_PAREN;
+    } else {
+        throw std::domain_error("Unrecognized symbol");
+    }
+
+    return Token { kind, input.substr(start, pos - start) };
+}
+
+// Convert a run of digits to an int, rejecting values that don't fit.
+int Tokenizer::to_int(std::string_view digits)
+{
+    int value = 0;
+    auto result = std::from_chars(digits.data(), digits.data() + digits.size(), value);
+    if (result.ec == std::errc::result_out_of_range)
+        throw std::domain_error("Number out of range");
+    return value;
+}
@@ -0,0 +1,223 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#include "Tree_Traversal.h"
+#include "Component_Node.h"
+#include "Expression_Tree.h"
+
+Tree_Traversal::Order Tree_Traversal::order(const std::string& name)
+{
+    if (name == "in-order")
+        return IN_ORDER;
+    if (name == "pre-order")
+        return PRE_ORDER;
+    if (name == "post-order")
+        return POST_ORDER;
+    if (name == "level-order")
+        return LEVEL_ORDER;
+    throw Expression_Tree::Invalid_Iterator(name);
+}
+
+Tree_Traversal::Tree_Traversal(const Component_Node* root, Order order, bool threaded)
+    : walk_order(order)
+    , root(root)
+    , current(nullptr)
+    , use_links(threaded && root && root->threaded() && order != LEVEL_ORDER)
+    , entries(inline_entries)
+    , capacity(inline_capacity)
+    , first(0)
+    , count(0)
+{
+    if (use_links) {
+        current = first_linked(root);
+        return;
+    }
+    if (!root)
+        return;
+
+    // a stack never holds more than one node per level for pre- and
+    // in-order, or two for post-order; a level-order queue grows
+    std::size_t needed = root->height() + 1;
+    if (order == POST_ORDER)
+        needed = 2 * root->height() + 1;
+    if (order != LEVEL_ORDER && needed > capacity) {
+        heap_entries.reset(new Entry[needed]);
+        entries = heap_entries.get();
+        capacity = needed;
+    }
+
+    if (order == IN_ORDER) {
+        push_left(root);
+    } else {
+        push(root);
+        if (order == POST_ORDER)
+            descend();
+    }
+}
+
+const Component_Node* Tree_Traversal::next()
+{
+    if (use_links) {
+        const Component_Node* node = current;
+        if (node)
+            current = next_linked(node);
+        return node;
+    }
+    if (count == 0)
+        return nullptr;
+
+    const Component_Node* node;
+    switch (walk_order) {
+    case PRE_ORDER:
+        node = entries[--count].node;
+        // right first, so the left child comes out first
+        if (node->right())
+            push(node->right());
+        if (node->left())
+            push(node->left());
+        break;
+    case IN_ORDER:
+        node = entries[--count].node;
+        if (node->right())
+            push_left(node->right());
+        break;
+    case POST_ORDER:
+        node = entries[--count].node;
+        if (count)
+            descend();
+        break;
+    case LEVEL_ORDER:
+    default:
+        node = entries[first].node;
+        first = (first + 1) % capacity;
+        --count;
+        if (node->left())
+            push(node->left());
+        if (node->right())
+            push(node->right());
+        break;
+    }
+    return node;
+}
+
+bool Tree_Traversal::threaded() const
+{
+    return use_links;
+}
+
+Tree_Traversal::iterator Tree_Traversal::begin()
+{
+    return iterator(this, next());
+}
+
+Tree_Traversal::iterator Tree_Traversal::end()
+{
+    return iterator(this, nullptr);
+}
+
+void Tree_Traversal::push(const Component_Node* node, bool expanded)
+{
+    if (walk_order != LEVEL_ORDER) {
+        entries[count++] = Entry { node, expanded };
+        return;
+    }
+
+    if (count == capacity) {
+        // double the ring, unrolling it to start at 0
+        std::unique_ptr<Entry[]> larger(new Entry[2 * capacity]);
+        for (std::size_t i = 0; i < count; ++i)
+            larger[i] = entries[(first + i) % capacity];
+        heap_entries = std::move(larger);
+        entries = heap_entries.get();
+        capacity *= 2;
+        first = 0;
+    }
+    entries[(first + count++) % capacity] = Entry { node, expanded };
+}
+
+void Tree_Traversal::push_left(const Component_Node* node)
+{
+    for (; node; node = node->left())
+        push(node);
+}
+
+// Same as the post-order iterator: the right child is pushed first so
+// the left one is visited first.
+void Tree_Traversal::descend()
+{
+    while (!entries[count - 1].expanded) {
+        Entry& top = entries[count - 1];
+        top.expanded = true;
+        const Component_Node* node = top.node;
+        if (node->right())
+            push(node->right());
+        if (node->left())
+            push(node->left());
+    }
+}
+
+const Component_Node* Tree_Traversal::first_linked(const Component_Node* node) const
+{
+    switch (walk_order) {
+    case IN_ORDER:
+        while (node->left())
+            node = node->left();
+        break;
+    case POST_ORDER:
+        // the deepest node reached by going left whenever possible
+        for (;;) {
+            if (node->left())
+                node = node->left();
+            else if (node->right())
+                node = node->right();
+            else
+                break;
+        }
+        break;
+    default:
+        break;
+    }
+    return node;
+}
+
+// Each step goes down to a child, or up until the parent has something
+// left to visit.  The walk never climbs above the root, whose own
+// parent may belong to another tree.
+const Component_Node* Tree_Traversal::next_linked(const Component_Node* node) const
+{
+    switch (walk_order) {
+    case PRE_ORDER:
+        if (node->left())
+            return node->left();
+        if (node->right())
+            return node->right();
+        for (; node != root; node = node->parent()) {
+            const Component_Node* parent = node->parent();
+            if (node == parent->left() && parent->right())
+                return parent->right();
+        }
+        return nullptr;
+    case IN_ORDER:
+        if (node->right())
+            return first_linked(node->right());
+        for (; node != root; node = node->parent()) {
+            if (node == node->parent()->left())
+                return node->parent();
+        }
+        return nullptr;
+    case POST_ORDER:
+    default: {
+        if (node == root)
+            return nullptr;
+        const Component_Node* parent = node->parent();
+        if (node == parent->left() && parent->right())
+            return first_linked(parent->right());
+        return parent;
+    }
+    }
+}
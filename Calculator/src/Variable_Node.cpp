@@ -0,0 +1,42 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+#include "Variable_Node.h"
+#include "Interpreter.h"
+#include "Visitor.h"
+
+// Ctor
+Variable_Node::Variable_Node(const Interpreter_Context& context, int slot)
+    : Component_Node()
+    , int_context(context)
+    , index(slot)
+{
+}
+
+// return the live value of the variable
+int Variable_Node::item() const
+{
+    return int_context.get(index);
+}
+
+// return the slot of the variable
+int Variable_Node::slot() const
+{
+    return index;
+}
+
+// return the context of the variable
+const Interpreter_Context& Variable_Node::context() const
+{
+    return int_context;
+}
+
+void Variable_Node::accept(Visitor& visitor) const
+{
+    visitor.visit(*this);
+}
@@ -1,8 +1,213 @@
 /* Copyright G. Hemingway @ 2019, All Rights Reserved */
+#include "Batch_Evaluator.h"
+#include "Bytecode.h"
+#include "Connection_Queue.h"
 #include "Expression_Tree_Event_Handler.h"
+#include "Expression_Tree_Server.h"
+#include "Interpreter.h"
+#include "Job_Executor.h"
+#include "Optimization_Visitor.h"
 #include "Options.h"
 #include "Reactor.h"
+#include <algorithm>
 #include <iostream>
+#include <pthread.h>
+#include <sched.h>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+// Connections the first event loop may hand to each of the others
+// before they are served.
+static const std::size_t WAITING_CONNECTIONS = 1024;
+
+// Evaluate @a expression for every row of the table on @a in and write
+// one result per row to @a out.  The first line of the table names the
+// variables, and every line after it holds one value per variable.
+static int run_batch(const std::string& expression, std::istream& in, std::ostream& out)
+{
+    Interpreter_Context context;
+    // the interpreter reports a missing operand itself and returns an
+    // empty tree, so its message is kept to be reported once below
+    std::ostringstream messages;
+    Interpreter interpreter(Options::instance()->share_subtrees(), messages);
+    Expression_Tree tree;
+    try {
+        tree = interpreter.interpret(context, expression);
+    } catch (std::domain_error& e) {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+    if (tree.is_null()) {
+        std::cerr << (messages.str().empty() ? "ERROR: Empty expression\n" : messages.str())
+                  << std::flush;
+        return 1;
+    }
+    if (Options::instance()->optimize()) {
+        Optimization_Visitor optimizer(Options::instance()->share_subtrees());
+        tree = optimizer.optimize(tree);
+    }
+
+    std::string line;
+    std::getline(in, line);
+    std::istringstream header(line);
+    std::vector<int> slots;
+    for (std::string name; header >> name;)
+        slots.push_back(context.slot(name));
+
+    // read the rows into one column per variable
+    std::vector<std::vector<int>> table(slots.size());
+    for (std::size_t row = 1; std::getline(in, line); ++row) {
+        std::istringstream values(line);
+        std::size_t count = 0;
+        for (int value; count < slots.size() && values >> value; ++count)
+            table[count].push_back(value);
+        if (count == 0 && values.eof())
+            continue;
+        if (count != slots.size() || !(values >> std::ws).eof()) {
+            std::cerr << "ERROR: Row " << row << " must have " << slots.size() << " values"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    std::size_t rows = slots.empty() ? 0 : table[0].size();
+    std::vector<const int*> columns(context.size(), nullptr);
+    for (std::size_t i = 0; i < slots.size(); ++i)
+        columns[slots[i]] = table[i].data();
+
+    std::vector<int> results(rows);
+    std::vector<char> errors(rows);
+    Batch_Evaluator evaluator(tree.bytecode());
+    evaluator.evaluate(columns, rows, results.data(), errors.data());
+
+    for (std::size_t row = 0; row < rows; ++row) {
+        if (errors[row] == Bytecode::MODULUS)
+            out << "ERROR: Modulus by zero\n";
+        else if (errors[row])
+            out << "ERROR: Division by zero\n";
+        else
+            out << results[row] << '\n';
+    }
+    out.flush();
+    return 0;
+}
+
+// Evaluate the jobs on @a in on several threads and write one result per
+// job to @a out, in order.  Each line is an expression, optionally
+// followed by ';' and name=value bindings for its variables.
+static int run_jobs(std::size_t threads, std::istream& in, std::ostream& out)
+{
+    std::vector<Job_Executor::Job> jobs;
+    std::string line;
+    for (std::size_t number = 1; std::getline(in, line); ++number) {
+        std::string::size_type separator = line.find(';');
+        Job_Executor::Job job { line.substr(0, separator), {} };
+        if (job.expression.find_first_not_of(" \t") == std::string::npos)
+            continue;
+
+        if (separator != std::string::npos) {
+            std::string bindings = line.substr(separator + 1);
+            std::replace(bindings.begin(), bindings.end(), ',', ' ');
+            std::istringstream stream(bindings);
+            for (std::string binding; stream >> binding;) {
+                std::string::size_type equals = binding.find('=');
+                char* end = nullptr;
+                long value = equals == std::string::npos
+                    ? 0
+                    : std::strtol(binding.c_str() + equals + 1, &end, 10);
+                if (equals == std::string::npos || equals == 0 || *end != '\0') {
+                    std::cerr << "ERROR: Bad binding '" << binding << "' on line " << number
+                              << std::endl;
+                    return 1;
+                }
+                job.bindings.emplace_back(binding.substr(0, equals), static_cast<int>(value));
+            }
+        }
+        jobs.push_back(std::move(job));
+    }
+
+    Job_Executor executor(threads);
+    std::vector<Job_Executor::Result> results = executor.run(jobs);
+
+    for (const Job_Executor::Result& result : results) {
+        if (result.status == Job_Executor::OK)
+            out << result.value << '\n';
+        else if (result.status == Job_Executor::DIVISION_BY_ZERO)
+            out << "ERROR: Division by zero\n";
+        else if (result.status == Job_Executor::MODULUS_BY_ZERO)
+            out << "ERROR: Modulus by zero\n";
+        else
+            out << "ERROR: Invalid expression\n";
+    }
+    out.flush();
+
+    if (Options::instance()->verbose())
+        executor.print_statistics(std::cerr);
+    return 0;
+}
+
+// Serve clients on @a address with @a reactors event loops, or one per
+// core if it's 0.  Each loop runs on a thread of its own, pinned to a
+// core.  On a TCP port every loop accepts and serves its own
+// connections, so the loops share nothing but the address.  A Unix
+// socket is accepted by the first loop, which hands the connections to
+// the others through a Connection_Queue each.
+static int run_servers(const std::string& address, std::size_t reactors)
+{
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    sched_getaffinity(0, sizeof(allowed), &allowed);
+    std::vector<int> cores;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        if (CPU_ISSET(cpu, &allowed))
+            cores.push_back(cpu);
+    if (reactors == 0)
+        reactors = cores.size();
+
+    // the handler each event loop starts with
+    std::vector<std::unique_ptr<Event_Handler>> handlers;
+    try {
+        Expression_Tree_Server* server = new Expression_Tree_Server(address);
+        handlers.emplace_back(server);
+        std::vector<Connection_Queue*> queues;
+        while (handlers.size() < reactors) {
+            if (server->reuses_port()) {
+                handlers.emplace_back(server->clone());
+            } else {
+                queues.push_back(new Connection_Queue(WAITING_CONNECTIONS));
+                handlers.emplace_back(queues.back());
+            }
+        }
+        server->hand_off(queues);
+    } catch (std::domain_error& e) {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+
+    auto serve = [&cores, reactors](Event_Handler* handler, std::size_t index) {
+        if (reactors > 1) {
+            cpu_set_t core;
+            CPU_ZERO(&core);
+            CPU_SET(cores[index % cores.size()], &core);
+            pthread_setaffinity_np(pthread_self(), sizeof(core), &core);
+        }
+
+        // every thread has a reactor of its own
+        std::unique_ptr<Reactor> reactor(Reactor::instance());
+        reactor->register_input_handler(handler);
+        reactor->run_event_loop();
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t index = 1; index < handlers.size(); ++index)
+        threads.emplace_back(serve, handlers[index].release(), index);
+    serve(handlers.front().release(), 0);
+
+    for (std::thread& thread : threads)
+        thread.join();
+    return 0;
+}
 
 int main(int argc, char* argv[])
 {
@@ -14,6 +219,19 @@ int main(int argc, char* argv[])
         return 0;
     }
 
+    // Evaluate a table instead of reading commands.
+    if (!options->batch().empty())
+        return run_batch(options->batch(), std::cin, std::cout);
+
+    // Evaluate independent jobs instead of reading commands.
+    if (options->parallel())
+        return run_jobs(options->job_threads(), std::cin, std::cout);
+
+    // Serve clients instead of standard input.  Every connection gets
+    // its own event handler.
+    if (!options->serve().empty())
+        return run_servers(options->serve(), options->reactors());
+
     // Create Reactor singleton to run application event loop.
     std::unique_ptr<Reactor> reactor(Reactor::instance());
 
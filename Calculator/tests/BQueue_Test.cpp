@@ -0,0 +1,218 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+// Checks the single and batch try_ methods of BQueue and of its SPSC
+// version, including what they return on a full and an empty queue,
+// then moves items between threads through both and checks that every
+// item arrives once, in order from each producer.
+
+#include "BQueue.h"
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+// Items each producer sends in the threaded checks.
+const int ITEMS = 200000;
+
+int failures = 0;
+
+// Report a failure if @a actual isn't @a expected.
+void check(const std::string& what, long long actual, long long expected)
+{
+    if (actual != expected) {
+        std::cerr << what << ": expected " << expected << ", got " << actual << std::endl;
+        ++failures;
+    }
+}
+
+// Number of Counted items that haven't been destroyed.
+int alive = 0;
+
+/**
+ * @struct Counted
+ * @brief An int that counts its live copies.
+ */
+struct Counted {
+    Counted(int value = 0)
+        : value(value)
+    {
+        ++alive;
+    }
+    Counted(const Counted& other)
+        : value(other.value)
+    {
+        ++alive;
+    }
+    Counted& operator=(const Counted&) = default;
+    ~Counted()
+    {
+        --alive;
+    }
+    int value;
+};
+
+// Check one queue on a single thread.
+template <bool SPSC> void single_thread(const std::string& name)
+{
+    {
+        // room is rounded up to a power of two
+        BQueue<int, SPSC> queue(5);
+        check(name + " capacity", queue.capacity(), 8);
+        check(name + " smallest capacity", BQueue<int, SPSC>(0).capacity(), 2);
+
+        int item = -1;
+        check(name + " dequeue from empty", queue.try_dequeue(item), false);
+        check(name + " item left alone", item, -1);
+        check(name + " empty", queue.is_empty(), true);
+
+        for (int i = 0; i < 8; ++i)
+            check(name + " enqueue " + std::to_string(i), queue.try_enqueue(i), true);
+        check(name + " enqueue onto full", queue.try_enqueue(8), false);
+        check(name + " full", queue.is_full(), true);
+        check(name + " size when full", queue.size(), 8);
+        try {
+            queue.enqueue(8);
+            std::cerr << name << ": enqueue() onto a full queue didn't throw" << std::endl;
+            ++failures;
+        } catch (typename BQueue<int, SPSC>::Overflow&) {
+        }
+
+        // first in, first out, across the end of the ring
+        for (int i = 0; i < 5; ++i)
+            check(name + " dequeue", queue.dequeue(), i);
+        for (int i = 8; i < 13; ++i)
+            queue.enqueue(i);
+        for (int i = 5; i < 13; ++i) {
+            check(name + " dequeue after wrapping", queue.try_dequeue(item), true);
+            check(name + " item after wrapping", item, i);
+        }
+        try {
+            queue.dequeue();
+            std::cerr << name << ": dequeue() from an empty queue didn't throw" << std::endl;
+            ++failures;
+        } catch (typename BQueue<int, SPSC>::Underflow&) {
+        }
+    }
+
+    {
+        // batches stop at a full or an empty queue
+        BQueue<int, SPSC> queue(8);
+        int items[12];
+        for (int i = 0; i < 12; ++i)
+            items[i] = i;
+        check(name + " batch enqueue", queue.try_enqueue(items, 6), 6);
+        check(name + " batch enqueue onto nearly full", queue.try_enqueue(items + 6, 6), 2);
+        check(name + " batch enqueue onto full", queue.try_enqueue(items + 8, 4), 0);
+
+        int out[12] = {};
+        check(name + " batch dequeue", queue.try_dequeue(out, 3), 3);
+        check(name + " batch dequeue of the rest", queue.try_dequeue(out + 3, 9), 5);
+        check(name + " batch dequeue from empty", queue.try_dequeue(out + 8, 4), 0);
+        for (int i = 0; i < 8; ++i)
+            check(name + " batch item " + std::to_string(i), out[i], i);
+    }
+
+    {
+        // items left in the queue are destroyed with it
+        BQueue<Counted, SPSC> queue(4);
+        for (int i = 0; i < 3; ++i)
+            queue.try_enqueue(Counted(i));
+        Counted item;
+        queue.try_dequeue(item);
+        check(name + " item moved out", item.value, 0);
+        check(name + " items alive", alive, 3);
+    }
+    check(name + " items alive after the queue", alive, 0);
+}
+
+// Send ITEMS items from each of @a producers threads to @a consumers
+// threads, in batches of @a batch if it isn't 1, and check that every
+// item arrives once and each producer's items arrive in order.
+template <bool SPSC>
+void threads(const std::string& name, int producers, int consumers, std::size_t batch)
+{
+    BQueue<int, SPSC> queue(64);
+    std::vector<std::vector<int>> received(consumers);
+    std::vector<std::thread> running;
+
+    for (int producer = 0; producer < producers; ++producer) {
+        running.emplace_back([&, producer] {
+            std::vector<int> items(batch);
+            for (int i = 0; i < ITEMS;) {
+                std::size_t n = 0;
+                while (n < batch && i + static_cast<int>(n) < ITEMS) {
+                    items[n] = producer * ITEMS + i + static_cast<int>(n);
+                    ++n;
+                }
+                std::size_t sent
+                    = n == 1 ? queue.try_enqueue(items[0]) : queue.try_enqueue(items.data(), n);
+                if (sent == 0)
+                    std::this_thread::yield();
+                i += static_cast<int>(sent);
+            }
+        });
+    }
+
+    const std::size_t total = static_cast<std::size_t>(producers) * ITEMS;
+    std::atomic<std::size_t> taken(0);
+    for (int consumer = 0; consumer < consumers; ++consumer) {
+        running.emplace_back([&, consumer] {
+            std::vector<int> items(batch);
+            while (taken.load() < total) {
+                std::size_t n = batch == 1 ? queue.try_dequeue(items[0])
+                                           : queue.try_dequeue(items.data(), batch);
+                if (n == 0)
+                    std::this_thread::yield();
+                received[consumer].insert(
+                    received[consumer].end(), items.begin(), items.begin() + n);
+                taken += n;
+            }
+        });
+    }
+    for (std::thread& thread : running)
+        thread.join();
+
+    std::vector<int> seen(total, 0);
+    for (const std::vector<int>& items : received) {
+        std::vector<int> last(producers, -1);
+        for (int item : items) {
+            ++seen[item];
+            if (item <= last[item / ITEMS]) {
+                std::cerr << name << ": " << item << " arrived after " << last[item / ITEMS]
+                          << std::endl;
+                ++failures;
+                return;
+            }
+            last[item / ITEMS] = item;
+        }
+    }
+    for (std::size_t item = 0; item < total; ++item) {
+        if (seen[item] != 1) {
+            check(name + " copies of item " + std::to_string(item), seen[item], 1);
+            return;
+        }
+    }
+}
+}
+
+int main()
+{
+    single_thread<false>("BQueue");
+    single_thread<true>("BQueue SPSC");
+
+    threads<false>("BQueue 4 to 4", 4, 4, 1);
+    threads<false>("BQueue 4 to 4 in batches", 4, 4, 16);
+    threads<true>("BQueue SPSC", 1, 1, 1);
+    threads<true>("BQueue SPSC in batches", 1, 1, 16);
+
+    return failures ? 1 : 0;
+}
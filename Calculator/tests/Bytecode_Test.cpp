@@ -0,0 +1,209 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+// Compiles random expressions to bytecode and checks that running it
+// gives what an Evaluation_Visitor gives, including which of division
+// or modulus by zero stops it, on trees, on trees with shared subtrees,
+// and after the optimizer has rewritten them.  Also checks the shape of
+// the programs.
+
+#include "Bytecode.h"
+#include "Evaluation_Visitor.h"
+#include "Expression_Tree.h"
+#include "Interpreter.h"
+#include "Optimization_Visitor.h"
+#include "Tree_Traversal.h"
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace {
+// Number of expressions of each kind.
+const int EXPRESSIONS = 2000;
+
+// Values each expression is evaluated with.
+const int BINDINGS = 4;
+
+int failures = 0;
+
+std::mt19937 random_engine(3251);
+
+// Return a random number in [low, high].
+int random(int low, int high)
+{
+    return std::uniform_int_distribution<int>(low, high)(random_engine);
+}
+
+// Return a number or a variable.
+std::string random_leaf()
+{
+    static const char* variables[] = { "a", "b", "c" };
+    if (random(0, 2) == 0)
+        return variables[random(0, 2)];
+    return std::to_string(random(0, 9));
+}
+
+// Return a random expression at most @a depth operators deep.  Powers,
+// factorials and one side of each product only take small leaves, so
+// no value overflows an int.  With @a repeat, some subexpressions are
+// used twice so the interpreter can share them.
+std::string random_expression(int depth, bool repeat)
+{
+    if (depth == 0)
+        return random_leaf();
+
+    static const char binary[] = { '+', '-', '/', '%' };
+    switch (random(0, 9)) {
+    case 0:
+        return random_leaf();
+    case 1:
+        return "-(" + random_expression(depth - 1, repeat) + ")";
+    case 2:
+        return std::to_string(random(0, 5)) + "!";
+    case 3:
+        return "(" + random_leaf() + "^" + std::to_string(random(0, 3)) + ")";
+    case 4:
+        return "(" + random_leaf() + "*" + random_expression(depth - 1, repeat) + ")";
+    default: {
+        std::string lhs = random_expression(depth - 1, repeat);
+        std::string rhs = repeat && random(0, 2) == 0 ? lhs : random_expression(depth - 1, repeat);
+        return "(" + lhs + binary[random(0, 3)] + rhs + ")";
+    }
+    }
+}
+
+/**
+ * @struct Outcome
+ * @brief A value, or the operator that divided by zero.
+ */
+struct Outcome {
+    bool evaluated;
+    int value;
+    Bytecode::Opcode failed;
+};
+
+// Evaluate @a tree by walking it with an Evaluation_Visitor.  The
+// first error it reports is the one that stops the bytecode.
+Outcome visit(const Expression_Tree& tree)
+{
+    std::ostringstream errors;
+    Evaluation_Visitor visitor(errors);
+    Tree_Traversal traversal(tree.get_root(), Tree_Traversal::POST_ORDER);
+    while (const Component_Node* node = traversal.next())
+        node->accept(visitor);
+
+    std::string message = errors.str();
+    std::string::size_type division = message.find("Division by zero");
+    std::string::size_type modulus = message.find("Modulus by zero");
+    if (division < modulus)
+        return Outcome { false, 0, Bytecode::DIVIDE };
+    if (modulus < division)
+        return Outcome { false, 0, Bytecode::MODULUS };
+    return Outcome { true, visitor.total(), Bytecode::RETURN };
+}
+
+// Run the bytecode of @a tree with the variables of @a context.
+Outcome run(const Expression_Tree& tree, const Interpreter_Context& context)
+{
+    Outcome outcome { false, 0, Bytecode::RETURN };
+    outcome.evaluated = tree.bytecode().evaluate(context.data(), outcome.value, &outcome.failed);
+    return outcome;
+}
+
+// Report a failure if @a actual differs from @a expected.
+void compare(const std::string& expression, const char* name, const Outcome& actual,
+    const Outcome& expected)
+{
+    auto describe = [](const Outcome& outcome) {
+        if (outcome.evaluated)
+            return std::to_string(outcome.value);
+        return std::string(outcome.failed == Bytecode::MODULUS ? "modulus" : "division")
+            + " by zero";
+    };
+    if (actual.evaluated != expected.evaluated
+        || (actual.evaluated ? actual.value != expected.value : actual.failed != expected.failed)) {
+        std::cerr << expression << ": " << name << " gave " << describe(actual)
+                  << ", the visitor gave " << describe(expected) << std::endl;
+        ++failures;
+    }
+}
+
+// Check the shape of the program compiled from @a tree.
+void check_program(const std::string& expression, const Expression_Tree& tree, bool share)
+{
+    const Bytecode& bytecode = tree.bytecode();
+    const auto& program = bytecode.program();
+    if (program.empty() || program.back().op != Bytecode::RETURN || bytecode.depth() == 0) {
+        std::cerr << expression << ": the program doesn't end in RETURN" << std::endl;
+        ++failures;
+        return;
+    }
+    // a tree is one instruction per node, with no temporaries
+    if (!share
+        && (program.size() != tree.get_root()->size() + 1 || bytecode.temporaries() != 0)) {
+        std::cerr << expression << ": " << program.size() << " instructions and "
+                  << bytecode.temporaries() << " temporaries for " << tree.get_root()->size()
+                  << " nodes" << std::endl;
+        ++failures;
+    }
+}
+}
+
+int main()
+{
+    int errors[2] = {};
+    int loads = 0;
+
+    for (bool share : { false, true }) {
+        Interpreter interpreter(share, std::cerr);
+        Optimization_Visitor optimizer(share);
+        Interpreter_Context context;
+        for (int i = 0; i < EXPRESSIONS; ++i) {
+            std::string expression = random_expression(random(1, 6), share);
+            Expression_Tree tree = interpreter.interpret(context, expression);
+            Expression_Tree optimized = optimizer.optimize(tree);
+            check_program(expression, tree, share);
+            for (const auto& instruction : tree.bytecode().program())
+                loads += instruction.op == Bytecode::LOAD;
+
+            for (int binding = 0; binding < BINDINGS; ++binding) {
+                context.set("a", random(-9, 9));
+                context.set("b", random(-9, 9));
+                context.set("c", random(0, 1));
+
+                Outcome expected = visit(tree);
+                if (!expected.evaluated)
+                    ++errors[expected.failed == Bytecode::MODULUS];
+                compare(expression, "bytecode", run(tree, context), expected);
+                compare(expression, "optimized bytecode", run(optimized, context), expected);
+            }
+        }
+    }
+
+    // a tree without variables doesn't read the context
+    Interpreter interpreter;
+    Interpreter_Context context;
+    if (interpreter.interpret(context, "1 + 2 * 3").bytecode().variables() != nullptr) {
+        std::cerr << "a program without variables reads the context" << std::endl;
+        ++failures;
+    }
+
+    // make sure both errors and shared subtrees were actually tried
+    if (errors[0] == 0 || errors[1] == 0) {
+        std::cerr << "no expression divided or took the modulus by zero" << std::endl;
+        ++failures;
+    }
+    if (loads == 0) {
+        std::cerr << "no shared subtree was loaded from a temporary" << std::endl;
+        ++failures;
+    }
+
+    return failures ? 1 : 0;
+}
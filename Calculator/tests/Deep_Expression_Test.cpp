@@ -0,0 +1,99 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+// Builds, evaluates and frees expressions hundreds of thousands of levels
+// deep, which overflow the stack if any of those steps recurse once per
+// level.
+
+#include "Bytecode.h"
+#include "Evaluation_Visitor.h"
+#include "Expression_Tree.h"
+#include "Interpreter.h"
+#include "Optimization_Visitor.h"
+#include "Tree_Traversal.h"
+#include <cstddef>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+// Number of terms in each expression.
+const std::size_t TERMS = 300000;
+
+int failures = 0;
+
+// Report a failure if @a actual isn't @a expected.
+void check(const std::string& what, int actual, int expected)
+{
+    if (actual != expected) {
+        std::cerr << what << ": expected " << expected << ", got " << actual << std::endl;
+        ++failures;
+    }
+}
+
+// Return @a count copies of @a text.
+std::string repeat(const std::string& text, std::size_t count)
+{
+    std::string result;
+    result.reserve(text.size() * count);
+    for (std::size_t i = 0; i < count; ++i)
+        result += text;
+    return result;
+}
+
+// Evaluate @a tree with the bytecode and with a visitor walking it both
+// ways, then optimize it.
+void evaluate(const std::string& name, const Expression_Tree& tree, int expected)
+{
+    int result = 0;
+    if (!tree.bytecode().evaluate(result))
+        result = -1;
+    check(name + " bytecode", result, expected);
+
+    for (bool threaded : { false, true }) {
+        std::ostringstream errors;
+        Evaluation_Visitor visitor(errors);
+        Tree_Traversal traversal(tree.get_root(), Tree_Traversal::POST_ORDER, threaded);
+        while (const Component_Node* node = traversal.next())
+            node->accept(visitor);
+        check(name + (threaded ? " threaded walk" : " walk"), visitor.total(), expected);
+    }
+
+    Optimization_Visitor optimizer;
+    Expression_Tree optimized = optimizer.optimize(tree);
+    check(name + " optimized", optimized.item(), expected);
+}
+}
+
+int main()
+{
+    struct {
+        const char* name;
+        std::string expression;
+        int expected;
+    } cases[] = {
+        { "left-deep sum", "1" + repeat("+1", TERMS - 1), static_cast<int>(TERMS) },
+        { "negations", repeat("-", TERMS) + "1", TERMS % 2 ? -1 : 1 },
+        { "right-deep sum", repeat("(1+", TERMS) + "1" + repeat(")", TERMS),
+            static_cast<int>(TERMS) + 1 },
+        { "factorials", "1" + repeat("!", TERMS), 1 },
+    };
+
+    for (bool share : { false, true }) {
+        Interpreter interpreter(share, std::cerr);
+        Interpreter_Context context;
+        for (auto& test : cases) {
+            std::string name = std::string(test.name) + (share ? " (shared)" : "");
+            // the tree goes away at the end of each iteration
+            Expression_Tree tree = interpreter.interpret(context, test.expression);
+            evaluate(name, tree, test.expected);
+        }
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,115 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+// Checks the hits, misses and least-recently-used evictions of an
+// Expression_Tree_Cache and its counters, that a capacity of 0 turns
+// it off, and that a cached tree sees variables set after it was built.
+
+#include "Bytecode.h"
+#include "Expression_Tree.h"
+#include "Expression_Tree_Cache.h"
+#include "Interpreter.h"
+#include <cstddef>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+int failures = 0;
+
+// Report a failure if @a actual isn't @a expected.
+void check(const std::string& what, long long actual, long long expected)
+{
+    if (actual != expected) {
+        std::cerr << what << ": expected " << expected << ", got " << actual << std::endl;
+        ++failures;
+    }
+}
+
+// Report a failure unless @a key is cached exactly when @a cached is
+// true.
+void lookup(Expression_Tree_Cache& cache, const std::string& key, bool cached)
+{
+    if ((cache.find(key) != nullptr) != cached) {
+        std::cerr << key << (cached ? " wasn't" : " was") << " cached" << std::endl;
+        ++failures;
+    }
+}
+
+// Return the value of @a tree.
+int evaluate(const Expression_Tree& tree)
+{
+    int result = 0;
+    tree.bytecode().evaluate(result);
+    return result;
+}
+}
+
+int main()
+{
+    Interpreter interpreter;
+    Interpreter_Context context;
+
+    // keys ignore whitespace but keep tokens apart
+    check("normalized key",
+        Expression_Tree_Cache::normalize(" 1+  x *(2) ") == "1 + x * ( 2 )", 1);
+    check("numbers kept apart", Expression_Tree_Cache::normalize("1 2") == "12", 0);
+    check("bad symbol", Expression_Tree_Cache::normalize("1 # 2").empty(), 1);
+
+    Expression_Tree_Cache cache(3);
+    const char* expressions[] = { "a + 1", "a + 2", "a + 3", "a + 4" };
+    for (int i = 0; i < 3; ++i) {
+        lookup(cache, expressions[i], false);
+        cache.insert(expressions[i], interpreter.interpret(context, expressions[i]));
+    }
+    check("size", cache.size(), 3);
+    check("misses", cache.misses(), 3);
+    check("hits", cache.hits(), 0);
+
+    // using "a + 1" makes "a + 2" the least recently used
+    lookup(cache, "a + 1", true);
+    cache.insert(expressions[3], interpreter.interpret(context, expressions[3]));
+    check("evictions", cache.evictions(), 1);
+    check("size after eviction", cache.size(), 3);
+    lookup(cache, "a + 2", false);
+    lookup(cache, "a + 1", true);
+    lookup(cache, "a + 3", true);
+    lookup(cache, "a + 4", true);
+    check("hits after eviction", cache.hits(), 4);
+    check("misses after eviction", cache.misses(), 4);
+
+    // inserting a key again keeps the tree that's there
+    const Expression_Tree* tree = cache.find("a + 4");
+    check("insert again", cache.insert("a + 4", Expression_Tree()) == tree, 1);
+    check("evictions after inserting again", cache.evictions(), 1);
+
+    // cached trees read the variables when they're evaluated
+    context.set("a", 10);
+    check("a + 4 with a = 10", evaluate(*cache.find("a + 4")), 14);
+    context.set("a", -4);
+    check("a + 4 with a = -4", evaluate(*cache.find("a + 4")), 0);
+
+    std::ostringstream counters;
+    cache.print(counters);
+    check("printed counters",
+        counters.str() == "cache: 3/3 trees, 7 hits, 4 misses, 1 evictions\n", 1);
+
+    cache.clear();
+    check("size after clear", cache.size(), 0);
+    lookup(cache, "a + 1", false);
+
+    // capacity 0 turns the cache off, without counting lookups
+    Expression_Tree_Cache off(0);
+    check("insert with the cache off",
+        off.insert("a + 1", interpreter.interpret(context, "a + 1")) == nullptr, 1);
+    lookup(off, "a + 1", false);
+    check("size with the cache off", off.size(), 0);
+    check("misses with the cache off", off.misses(), 0);
+
+    return failures ? 1 : 0;
+}
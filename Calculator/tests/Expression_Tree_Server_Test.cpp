@@ -0,0 +1,48 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+// Checks that the server only listens for TCP clients on loopback
+// addresses, since its sessions can't be authenticated.
+
+#include "Expression_Tree_Server.h"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+int failures = 0;
+
+// Try to listen on @a address and report a failure unless the server
+// refuses exactly when @a loopback is false.
+void listen(const std::string& address, bool loopback)
+{
+    try {
+        Expression_Tree_Server server(address);
+        if (!loopback) {
+            std::cerr << address << " was accepted" << std::endl;
+            ++failures;
+        }
+    } catch (const std::domain_error& error) {
+        if (loopback || std::string(error.what()).find("Not a loopback address") != 0) {
+            std::cerr << address << ": " << error.what() << std::endl;
+            ++failures;
+        }
+    }
+}
+}
+
+int main()
+{
+    // port 0 lets the system pick a free port
+    for (const char* address : { "0.0.0.0:0", "10.1.2.3:0", "192.168.0.1:0", "8.8.8.8:0" })
+        listen(address, false);
+    for (const char* address : { "0", "127.0.0.1:0", "127.1.2.3:0", "localhost:0" })
+        listen(address, true);
+
+    return failures ? 1 : 0;
+}
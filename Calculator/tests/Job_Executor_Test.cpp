@@ -0,0 +1,166 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+// Runs random jobs on Job_Executors with several threads and checks
+// that every result, in order, is what evaluating the job on its own
+// with an Evaluation_Visitor gives, including division and modulus by
+// zero and invalid expressions.
+
+#include "Evaluation_Visitor.h"
+#include "Expression_Tree.h"
+#include "Interpreter.h"
+#include "Job_Executor.h"
+#include "Tree_Traversal.h"
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+// Number of distinct expressions, and of jobs using them.
+const int EXPRESSIONS = 500;
+const int JOBS = 20000;
+
+int failures = 0;
+
+std::mt19937 random_engine(3251);
+
+// Return a random number in [low, high].
+int random(int low, int high)
+{
+    return std::uniform_int_distribution<int>(low, high)(random_engine);
+}
+
+// Return a number or a variable.
+std::string random_leaf()
+{
+    static const char* variables[] = { "a", "b", "c" };
+    if (random(0, 2) == 0)
+        return variables[random(0, 2)];
+    return std::to_string(random(0, 9));
+}
+
+// Return a random expression at most @a depth operators deep, whose
+// values fit in an int.
+std::string random_expression(int depth)
+{
+    if (depth == 0)
+        return random_leaf();
+
+    static const char binary[] = { '+', '-', '/', '%' };
+    switch (random(0, 7)) {
+    case 0:
+        return "-(" + random_expression(depth - 1) + ")";
+    case 1:
+        return "(" + random_leaf() + "*" + random_expression(depth - 1) + ")";
+    default:
+        return "(" + random_expression(depth - 1) + binary[random(0, 3)]
+            + random_expression(depth - 1) + ")";
+    }
+}
+
+// Evaluate @a job on its own, the way the command loop does.
+Job_Executor::Result evaluate(const Job_Executor::Job& job)
+{
+    std::ostringstream errors;
+    Interpreter interpreter(false, errors);
+    Interpreter_Context context;
+    Expression_Tree tree;
+    try {
+        tree = interpreter.interpret(context, job.expression);
+    } catch (std::domain_error&) {
+    }
+    if (tree.is_null())
+        return Job_Executor::Result { Job_Executor::INVALID_EXPRESSION, 0 };
+
+    for (const auto& binding : job.bindings)
+        if (context.find(binding.first) >= 0)
+            context.set(binding.first, binding.second);
+
+    Evaluation_Visitor visitor(errors);
+    Tree_Traversal traversal(tree.get_root(), Tree_Traversal::POST_ORDER);
+    while (const Component_Node* node = traversal.next())
+        node->accept(visitor);
+
+    // the first error is the one the job reports
+    std::string message = errors.str();
+    std::string::size_type division = message.find("Division by zero");
+    std::string::size_type modulus = message.find("Modulus by zero");
+    if (division < modulus)
+        return Job_Executor::Result { Job_Executor::DIVISION_BY_ZERO, 0 };
+    if (modulus < division)
+        return Job_Executor::Result { Job_Executor::MODULUS_BY_ZERO, 0 };
+    return Job_Executor::Result { Job_Executor::OK, visitor.total() };
+}
+}
+
+int main()
+{
+    std::vector<std::string> expressions;
+    for (int i = 0; i < EXPRESSIONS; ++i)
+        expressions.push_back(random_expression(random(1, 5)));
+    // a few that don't parse, which each executor reports on stderr
+    for (const char* invalid : { "1 +", "(2 * 3", "4 4", "1 + 2147483648", "" })
+        expressions.push_back(invalid);
+
+    // variables may be unbound, which makes them 0, or bound to names
+    // the expression doesn't use
+    std::vector<Job_Executor::Job> jobs;
+    for (int i = 0; i < JOBS; ++i) {
+        int expression = random(0, static_cast<int>(expressions.size()) - 1);
+        Job_Executor::Job job { expressions[expression], {} };
+        for (const char* name : { "a", "b", "c", "unused" })
+            if (random(0, 3) != 0)
+                job.bindings.emplace_back(name, random(-9, 9));
+        jobs.push_back(std::move(job));
+    }
+
+    std::vector<Job_Executor::Result> expected;
+    int counts[4] = {};
+    for (const Job_Executor::Job& job : jobs) {
+        expected.push_back(evaluate(job));
+        ++counts[expected.back().status];
+    }
+
+    for (std::size_t threads : { 1, 2, 4, 8 }) {
+        Job_Executor executor(threads);
+        std::vector<Job_Executor::Result> results = executor.run(jobs);
+        if (results.size() != expected.size()) {
+            std::cerr << threads << " threads: " << results.size() << " results for "
+                      << expected.size() << " jobs" << std::endl;
+            ++failures;
+            continue;
+        }
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            if (results[i].status != expected[i].status
+                || (results[i].status == Job_Executor::OK
+                    && results[i].value != expected[i].value)) {
+                std::cerr << threads << " threads, job " << i << " " << jobs[i].expression
+                          << ": got status " << results[i].status << " value "
+                          << results[i].value << ", expected status " << expected[i].status
+                          << " value " << expected[i].value << std::endl;
+                ++failures;
+                break;
+            }
+        }
+    }
+
+    // make sure every kind of result was actually tried
+    const char* names[] = { "ok", "division by zero", "modulus by zero", "invalid" };
+    for (int status = 0; status < 4; ++status) {
+        if (counts[status] == 0) {
+            std::cerr << "no job was " << names[status] << std::endl;
+            ++failures;
+        }
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,162 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+// Evaluates random expressions with the machine code, the bytecode and
+// an Evaluation_Visitor and checks that they agree, including on
+// division and modulus by zero and on trees with shared subtrees.
+
+#include "Bytecode.h"
+#include "Evaluation_Visitor.h"
+#include "Expression_Tree.h"
+#include "Interpreter.h"
+#include "Native_Code.h"
+#include "Tree_Traversal.h"
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace {
+// Number of expressions of each kind.
+const int EXPRESSIONS = 2000;
+
+// Values each expression is evaluated with.
+const int BINDINGS = 4;
+
+int failures = 0;
+
+std::mt19937 random_engine(3251);
+
+// Return a random number in [low, high].
+int random(int low, int high)
+{
+    return std::uniform_int_distribution<int>(low, high)(random_engine);
+}
+
+// Return a number or a variable.
+std::string random_leaf()
+{
+    static const char* variables[] = { "a", "b", "c" };
+    if (random(0, 2) == 0)
+        return variables[random(0, 2)];
+    return std::to_string(random(0, 9));
+}
+
+// Return a random expression at most @a depth operators deep.  Powers,
+// factorials and one side of each product only take small leaves, so
+// no value overflows an int.  With @a repeat, some subexpressions are
+// used twice so the interpreter can share them.
+std::string random_expression(int depth, bool repeat)
+{
+    if (depth == 0)
+        return random_leaf();
+
+    static const char binary[] = { '+', '-', '/', '%' };
+    switch (random(0, 9)) {
+    case 0:
+        return random_leaf();
+    case 1:
+        return "-(" + random_expression(depth - 1, repeat) + ")";
+    case 2:
+        return std::to_string(random(0, 5)) + "!";
+    case 3:
+        return "(" + random_leaf() + "^" + std::to_string(random(0, 3)) + ")";
+    case 4:
+        return "(" + random_leaf() + "*" + random_expression(depth - 1, repeat) + ")";
+    default: {
+        std::string lhs = random_expression(depth - 1, repeat);
+        std::string rhs = repeat && random(0, 2) == 0 ? lhs : random_expression(depth - 1, repeat);
+        return "(" + lhs + binary[random(0, 3)] + rhs + ")";
+    }
+    }
+}
+
+// Evaluate @a tree by walking it with an Evaluation_Visitor.  Returns
+// false if the visitor reported division or modulus by zero.
+bool visit(const Expression_Tree& tree, int& result)
+{
+    std::ostringstream errors;
+    Evaluation_Visitor visitor(errors);
+    Tree_Traversal traversal(tree.get_root(), Tree_Traversal::POST_ORDER);
+    while (const Component_Node* node = traversal.next())
+        node->accept(visitor);
+    result = visitor.total();
+    return errors.str().empty();
+}
+
+// Report a failure if @a name's outcome differs from the visitor's.
+void compare(const std::string& expression, const char* name, bool evaluated, int result,
+    bool expected_evaluated, int expected)
+{
+    if (evaluated != expected_evaluated || (evaluated && result != expected)) {
+        std::cerr << expression << ": " << name << " gave ";
+        if (evaluated)
+            std::cerr << result;
+        else
+            std::cerr << "an error";
+        std::cerr << ", the visitor gave ";
+        if (expected_evaluated)
+            std::cerr << expected;
+        else
+            std::cerr << "an error";
+        std::cerr << std::endl;
+        ++failures;
+    }
+}
+}
+
+int main()
+{
+    int translated = 0;
+    int errors = 0;
+
+    for (bool share : { false, true }) {
+        Interpreter interpreter(share, std::cerr);
+        Interpreter_Context context;
+        for (int i = 0; i < EXPRESSIONS; ++i) {
+            std::string expression = random_expression(random(1, 6), share);
+            Expression_Tree tree = interpreter.interpret(context, expression);
+            translated += tree.native_code().valid();
+
+            for (int binding = 0; binding < BINDINGS; ++binding) {
+                context.set("a", random(-9, 9));
+                context.set("b", random(-9, 9));
+                context.set("c", random(0, 1));
+
+                int expected;
+                bool expected_evaluated = visit(tree, expected);
+                errors += !expected_evaluated;
+
+                int result;
+                bool evaluated = tree.bytecode().evaluate(result);
+                compare(expression, "bytecode", evaluated, result, expected_evaluated, expected);
+
+                if (tree.native_code().valid()) {
+                    evaluated = tree.native_code().evaluate(result);
+                    compare(
+                        expression, "native code", evaluated, result, expected_evaluated, expected);
+                }
+            }
+        }
+    }
+
+#if defined(__x86_64__) && defined(__linux__)
+    // every one of these expressions is small enough to translate
+    if (translated != 2 * EXPRESSIONS) {
+        std::cerr << "only " << translated << " expressions were translated" << std::endl;
+        ++failures;
+    }
+#endif
+    // make sure the errors were actually tried
+    if (errors == 0) {
+        std::cerr << "no expression divided by zero" << std::endl;
+        ++failures;
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,110 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+// Optimizes expressions and checks the trees that come out: constants
+// folded, identities removed, small powers turned into products, and
+// constants whose result doesn't fit in an int, or that divide INT_MIN
+// by -1, left alone.
+
+#include "Expression_Tree.h"
+#include "Interpreter.h"
+#include "Optimization_Visitor.h"
+#include "Print_Visitor.h"
+#include "Tree_Traversal.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+int failures = 0;
+
+// Return the nodes of @a tree in pre-order, the way "print pre-order"
+// shows them.  Variables show their values.
+std::string print(const Expression_Tree& tree)
+{
+    std::ostringstream out;
+    Print_Visitor visitor(out);
+    Tree_Traversal traversal(tree.get_root(), Tree_Traversal::PRE_ORDER);
+    while (const Component_Node* node = traversal.next())
+        node->accept(visitor);
+    return out.str();
+}
+}
+
+int main()
+{
+    // x is 100 and y is 200, so they're easy to tell from constants
+    struct {
+        const char* expression;
+        // the optimized tree without and with shared subtrees
+        const char* expected;
+        const char* shared;
+    } cases[] = {
+        // folding
+        { "3*4+x", " + 12 100", nullptr },
+        { "x+(7-2)*3", " + 100 15", nullptr },
+        { "2^10", " 1024", nullptr },
+        { "2^30", " 1073741824", nullptr },
+        { "5!", " 120", nullptr },
+        { "12!", " 479001600", nullptr },
+        { "-2147483647-1", " -2147483648", nullptr },
+        { "-2147483647/-1", " 2147483647", nullptr },
+        { "7%-3", " 1", nullptr },
+        // identities
+        { "x*1", " 100", nullptr },
+        { "1*x", " 100", nullptr },
+        { "x+0", " 100", nullptr },
+        { "0+x", " 100", nullptr },
+        { "x-0", " 100", nullptr },
+        { "x/1", " 100", nullptr },
+        { "x^1", " 100", nullptr },
+        { "--x", " 100", nullptr },
+        { "x*(3-2)", " 100", nullptr },
+        // powers of leaves become products, and of other trees only
+        // when they're shared
+        { "x^2", " * 100 100", nullptr },
+        { "x^4", " * * * 100 100 100 100", nullptr },
+        { "x^5", "^ 100 5", nullptr },
+        { "(x+y)^2", "^ + 100 200 2", " * + 100 200 + 100 200" },
+        // errors are left for evaluation
+        { "4/0", " / 4 0", nullptr },
+        { "x%(1-1)", " % 100 0", nullptr },
+        // results that don't fit in an int
+        { "2147483647+1", " + 2147483647 1", nullptr },
+        { "-2147483647-2", " - -2147483647 2", nullptr },
+        { "65536*65536", " * 65536 65536", nullptr },
+        { "-(-2147483647-1)", "- -2147483648", nullptr },
+        { "(-2147483647-1)/-1", " / -2147483648 -1", nullptr },
+        { "(-2147483647-1)%-1", " % -2147483648 -1", nullptr },
+        { "2^31", "^ 2 31", nullptr },
+        { "0^-1", "^ 0 -1", nullptr },
+        { "13!", "! 13", nullptr },
+        { "(13!)+x", " +! 13 100", nullptr },
+    };
+
+    for (bool share : { false, true }) {
+        Interpreter interpreter(share, std::cerr);
+        Interpreter_Context context;
+        context.set("x", 100);
+        context.set("y", 200);
+        Optimization_Visitor optimizer(share);
+
+        for (const auto& test : cases) {
+            Expression_Tree tree = interpreter.interpret(context, test.expression);
+            std::string actual = print(optimizer.optimize(tree));
+            std::string expected = share && test.shared ? test.shared : test.expected;
+            if (actual != expected) {
+                std::cerr << test.expression << (share ? " (shared)" : "") << ": expected \""
+                          << expected << "\", got \"" << actual << "\"" << std::endl;
+                ++failures;
+            }
+        }
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,129 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+// Evaluates random trees with fork-join on pools of several sizes and
+// small split thresholds, and a tree large enough for the default
+// threshold, and checks that every result is the sequential one,
+// including division and modulus by zero.
+
+#include "Bytecode.h"
+#include "Expression_Tree.h"
+#include "Interpreter.h"
+#include "Parallel_Evaluator.h"
+#include "Thread_Pool.h"
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace {
+// Number of random expressions, and values each is evaluated with.
+const int EXPRESSIONS = 200;
+const int BINDINGS = 4;
+
+int failures = 0;
+
+std::mt19937 random_engine(3251);
+
+// Return a random number in [low, high].
+int random(int low, int high)
+{
+    return std::uniform_int_distribution<int>(low, high)(random_engine);
+}
+
+// Return a number or a variable.
+std::string random_leaf()
+{
+    static const char* variables[] = { "a", "b", "c" };
+    if (random(0, 2) == 0)
+        return variables[random(0, 2)];
+    return std::to_string(random(0, 9));
+}
+
+// Return a random expression at most @a depth operators deep, with
+// both sides of most operators large enough to be split.  Products
+// only take 0, 1 or 2 on one side, so no value overflows an int.
+std::string random_expression(int depth)
+{
+    if (depth == 0)
+        return random_leaf();
+
+    static const char binary[] = { '+', '-', '+', '-', '/', '%' };
+    switch (random(0, 9)) {
+    case 0:
+        return "-(" + random_expression(depth - 1) + ")";
+    case 1:
+        return "(" + std::to_string(random(0, 2)) + "*" + random_expression(depth - 1) + ")";
+    case 2:
+        return random_leaf();
+    default:
+        return "(" + random_expression(depth - 1) + binary[random(0, 5)]
+            + random_expression(depth - 1) + ")";
+    }
+}
+
+// Report a failure if fork-join on @a pool with @a threshold doesn't
+// give the bytecode's outcome for @a tree.
+void compare(const std::string& name, Thread_Pool& pool, std::size_t threshold,
+    const Expression_Tree& tree)
+{
+    int expected = 0;
+    bool expected_evaluated = tree.bytecode().evaluate(expected);
+    int result = 0;
+    bool evaluated = Parallel_Evaluator(pool, threshold).evaluate(tree.get_root(), result);
+
+    if (evaluated != expected_evaluated || (evaluated && result != expected)) {
+        std::cerr << name << " on " << pool.size() << " threads, threshold " << threshold
+                  << ": got " << (evaluated ? std::to_string(result) : "an error")
+                  << ", expected " << (expected_evaluated ? std::to_string(expected) : "an error")
+                  << std::endl;
+        ++failures;
+    }
+}
+}
+
+int main()
+{
+    Interpreter interpreter;
+    Interpreter_Context context;
+    Thread_Pool one(1), two(2), four(4);
+    Thread_Pool* pools[] = { &one, &two, &four };
+
+    int errors = 0;
+    for (int i = 0; i < EXPRESSIONS; ++i) {
+        std::string expression = random_expression(random(4, 12));
+        Expression_Tree tree = interpreter.interpret(context, expression);
+        for (int binding = 0; binding < BINDINGS; ++binding) {
+            context.set("a", random(-9, 9));
+            context.set("b", random(-9, 9));
+            context.set("c", random(0, 1));
+            int value;
+            errors += !tree.bytecode().evaluate(value);
+            for (Thread_Pool* pool : pools)
+                for (std::size_t threshold : { 2, 8, 64 })
+                    compare(expression, *pool, threshold, tree);
+        }
+    }
+
+    // make sure the errors were actually tried
+    if (errors == 0) {
+        std::cerr << "no expression divided by zero" << std::endl;
+        ++failures;
+    }
+
+    // a tree big enough to split at the default threshold: a balanced
+    // sum of 2^17 terms
+    std::string balanced = "1";
+    for (int level = 0; level < 17; ++level)
+        balanced = "(" + balanced + "+" + balanced + ")";
+    Expression_Tree tree = interpreter.interpret(context, balanced);
+    for (Thread_Pool* pool : pools)
+        compare("balanced sum", *pool, Parallel_Evaluator::default_threshold, tree);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,101 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+// Builds chains of a million objects, each holding the only reference
+// to the next, and drops them, which overflows the stack if releasing
+// an object recurses into the objects it holds.  Covers objects that
+// count their own references and objects counted through a Shim.
+
+#include "Refcounted.h"
+#include "Refcounter.h"
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <utility>
+
+namespace {
+// Number of links in each chain.
+const std::size_t LINKS = 1000000;
+
+int failures = 0;
+
+// Number of links that haven't been deleted.
+std::size_t alive = 0;
+
+// Report a failure if @a actual isn't @a expected.
+void check(const std::string& what, std::size_t actual, std::size_t expected)
+{
+    if (actual != expected) {
+        std::cerr << what << ": expected " << expected << ", got " << actual << std::endl;
+        ++failures;
+    }
+}
+
+/**
+ * @class Counted_Link
+ * @brief A link of a chain that counts its own references.
+ */
+struct Counted_Link : Refcounted<> {
+    Counted_Link()
+    {
+        ++alive;
+    }
+
+    ~Counted_Link()
+    {
+        --alive;
+    }
+
+    Refcounter<Counted_Link> next;
+};
+
+/**
+ * @class Shared_Link
+ * @brief A link of a chain whose references are counted in a Shim.
+ */
+struct Shared_Link {
+    Shared_Link()
+    {
+        ++alive;
+    }
+
+    ~Shared_Link()
+    {
+        --alive;
+    }
+
+    Refcounter<Shared_Link> next;
+};
+
+// Build a chain of LINKS links, drop it and check that every link was
+// deleted, and only once the last reference to the head was gone.
+template <typename Link> void chain(const std::string& name)
+{
+    {
+        Refcounter<Link> head(new Link);
+        for (std::size_t i = 1; i < LINKS; ++i) {
+            Refcounter<Link> link(new Link);
+            link->next = std::move(head);
+            head = std::move(link);
+        }
+        check(name + " links built", alive, LINKS);
+
+        Refcounter<Link> copy(head);
+        head = Refcounter<Link>();
+        check(name + " links kept by a copy", alive, LINKS);
+    }
+    check(name + " links left", alive, 0);
+}
+}
+
+int main()
+{
+    chain<Counted_Link>("counted");
+    chain<Shared_Link>("shim");
+    return failures ? 1 : 0;
+}
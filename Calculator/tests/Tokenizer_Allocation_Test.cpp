@@ -0,0 +1,110 @@
+// Author: Yumeng Jiang
+// VUnetid: jiany18
+// Email: yumeng.jiang@vanderbilt.edu
+// Class: CS3251
+// Date: 11/20/2019
+// Honor statement: I have neither given nor received any unauthorized aid on this assignment.
+// Assignment Number: Project #7
+
+// Counts the heap allocations made while tokenizing an expression,
+// converting its numbers and looking up its variables, which should be
+// none, and checks that numbers that don't fit in an int are rejected,
+// both by the tokenizer and in an expression.
+
+#include "Interpreter.h"
+#include "Tokenizer.h"
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+namespace {
+// Number of calls to operator new so far.
+std::size_t allocations = 0;
+
+int failures = 0;
+
+// Report a failure if @a actual isn't @a expected.
+void check(const std::string& what, long long actual, long long expected)
+{
+    if (actual != expected) {
+        std::cerr << what << ": expected " << expected << ", got " << actual << std::endl;
+        ++failures;
+    }
+}
+
+// Tokenize @a input the way the interpreter does and return the sum of
+// its numbers and variables.
+long long parse(Interpreter_Context& context, const std::string& input)
+{
+    long long sum = 0;
+    Tokenizer tokenizer(input);
+    for (auto token = tokenizer.next(); token.kind != Tokenizer::END; token = tokenizer.next()) {
+        if (token.kind == Tokenizer::NUMBER)
+            sum += Tokenizer::to_int(token.text);
+        else if (token.kind == Tokenizer::VARIABLE)
+            sum += context.get(context.slot(token.text));
+    }
+    return sum;
+}
+}
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* memory = std::malloc(size ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+int main()
+{
+    // names longer than the small string buffer would allocate if they
+    // were copied into a std::string
+    const std::string input
+        = "(first_long_variable_name + 12) * second_long_variable_name - 345 % 6 ^ 7 + "
+          "first_long_variable_name / 2147483647";
+
+    Interpreter_Context context;
+    context.set("first_long_variable_name", 3);
+    context.set("second_long_variable_name", 4);
+
+    std::size_t before = allocations;
+    long long sum = parse(context, input);
+    check("allocations while parsing", allocations - before, 0);
+    check("sum of operands", sum, 3 + 12 + 4 + 345 + 6 + 7 + 3 + 2147483647LL);
+
+    check("largest int", Tokenizer::to_int("2147483647"), 2147483647);
+    for (const char* digits : { "2147483648", "99999999999999999999999" }) {
+        try {
+            Tokenizer::to_int(digits);
+            std::cerr << digits << " was accepted" << std::endl;
+            ++failures;
+        } catch (std::domain_error&) {
+        }
+    }
+
+    // the interpreter reports an overflowing literal instead of
+    // wrapping it
+    Interpreter interpreter;
+    try {
+        interpreter.interpret(context, "1 + 2147483648");
+        std::cerr << "1 + 2147483648 was interpreted" << std::endl;
+        ++failures;
+    } catch (std::domain_error&) {
+    }
+
+    return failures ? 1 : 0;
+}